@@ -11,7 +11,10 @@
 /*includes*/
 #include <stdio.h>
 #include <malloc.h>
+#include <string.h>
 #include "padroes.h"
+#include "desempenho.h"
+#include "espalhamento.h"
 
 /*Novos tipos e estruturas*/
 
@@ -24,6 +27,7 @@
 typedef struct sArvore {
 	tChave chave; /**chave discriminante*/
 	tDados dado; /**dados contido na arvore*/
+	signed char altura; /**altura da subarvore com raiz neste no, uma para a folha*/
 
 	struct sArvore *direita; /**filho menor*/
 	struct sArvore *esquerda; /**filho maior*/
@@ -34,11 +38,9 @@ typedef tNoArvore* tArvore; /**tipo para arvore*/
 /*prototipos de funcoes*/
 void criarArvore(tArvore*);
 tControle inserirArvore(tArvore*, tDados);
-tControle buscarArvore(tArvore, char*, tDados*);
+tControle buscarArvore(tArvore, const char*, tDados*);
 void destruirArvore(tArvore*);
 
-static tChave _hashA(char*);
-
 /*funcoes e procedimentos*/
 /**
  * Cria uma arvore
@@ -51,10 +53,138 @@ void criarArvore(tArvore *semente) {
 	(*semente) = NULL;
 }
 
+/**
+ * Compara uma chave com a de um no. Funcao para uso interno.
+ *
+ * A arvore eh ordenada pelo hash e, entre hashes iguais, pelo nome, assim dois
+ *  nomes diferentes nunca sao confundidos. O texto do nome so eh lido quando os
+ *  hashes coincidem e os enderecos nao, o que quase nunca acontece com nomes da
+ *  tabela de nomes.
+ *
+ * @param chave tChave : hash do nome procurado.
+ * @param nome const char* : nome procurado.
+ * @param no const tNoArvore* : no comparado.
+ * @return int : negativo se a chave vem antes da do no, zero se sao iguais e
+ *          positivo se vem depois.
+ */
+static int _compararNo(tChave chave, const char *nome, const tNoArvore *no) {
+
+	if (chave != no->chave)
+		return chave < no->chave ? -1 : 1;
+
+	return nome == no->dado.nome ? 0 : strcmp(nome, no->dado.nome);
+}
+
+/**
+ * Altura de uma subarvore, zero se vazia. Funcao para uso interno.
+ */
+static signed char _altura(const tNoArvore *no) {
+
+	return no ? no->altura : 0;
+}
+
+/**
+ * Recalcula a altura de um no a partir dos filhos. Funcao para uso interno.
+ */
+static void _atualizarAltura(tNoArvore *no) {
+
+	auto signed char menor = _altura(no->direita), maior = _altura(no->esquerda);
+
+	no->altura = (menor > maior ? menor : maior) + 1;
+}
+
+/**
+ * Rotacao que sobe o filho menor. Funcao para uso interno.
+ *
+ * @param raiz tArvore* : endereco da raiz da subarvore, recebe a nova raiz.
+ */
+static void _subirMenor(tArvore *raiz) {
+
+	auto tNoArvore *antiga = *raiz, *nova = antiga->direita;
+
+	antiga->direita = nova->esquerda;
+	nova->esquerda = antiga;
+	_atualizarAltura(antiga);
+	_atualizarAltura(nova);
+
+	*raiz = nova;
+}
+
+/**
+ * Rotacao que sobe o filho maior. Funcao para uso interno.
+ *
+ * @param raiz tArvore* : endereco da raiz da subarvore, recebe a nova raiz.
+ */
+static void _subirMaior(tArvore *raiz) {
+
+	auto tNoArvore *antiga = *raiz, *nova = antiga->esquerda;
+
+	antiga->esquerda = nova->direita;
+	nova->direita = antiga;
+	_atualizarAltura(antiga);
+	_atualizarAltura(nova);
+
+	*raiz = nova;
+}
+
+/**
+ * Rebalanceia uma subarvore. Funcao para uso interno.
+ *
+ * Depois de uma insercao as alturas dos filhos diferem de no maximo dois; uma
+ *  ou duas rotacoes deixam a diferenca em no maximo um (arvore AVL), entao a
+ *  altura da arvore fica proporcional ao logaritmo do numero de nos mesmo com
+ *  nomes inseridos em ordem, como v1, v2, v3...
+ *
+ * @param raiz tArvore* : endereco da raiz da subarvore.
+ */
+static void _balancear(tArvore *raiz) {
+
+	auto tNoArvore *no = *raiz;
+	auto int fator = _altura(no->direita) - _altura(no->esquerda);
+
+	if (fator > 1) {
+		if (_altura(no->direita->direita) < _altura(no->direita->esquerda))
+			_subirMaior(&no->direita);
+		_subirMenor(raiz);
+	}
+	else if (fator < -1) {
+		if (_altura(no->esquerda->esquerda) < _altura(no->esquerda->direita))
+			_subirMenor(&no->esquerda);
+		_subirMaior(raiz);
+	}
+	else
+		_atualizarAltura(no);
+}
+
+/**
+ * Insere um no em uma subarvore. Funcao para uso interno.
+ *
+ * @param raiz tArvore* : endereco da raiz da subarvore.
+ * @param novo tNoArvore* : no a inserir, ja com chave e dados.
+ * @return SUCESSO se inserir e ERRO se o nome ja existia.
+ */
+static tControle _inserirNo(tArvore *raiz, tNoArvore *novo) {
+
+	auto int comparacao;
+
+	if (!*raiz) {
+		*raiz = novo;
+		return SUCESSO;
+	}
+
+	if (!(comparacao = _compararNo(novo->chave, novo->dado.nome, *raiz))
+			|| _inserirNo(comparacao < 0 ? &(*raiz)->direita : &(*raiz)->esquerda, novo) != SUCESSO)
+		return ERRO;
+
+	_balancear(raiz);
+	return SUCESSO;
+}
+
 /**
  * Insere um elemento na arvore
  *
- * Faz a insercao de um elemento na arvore do modo que deve ser inserido.
+ * Faz a insercao de um elemento na arvore do modo que deve ser inserido,
+ *  rebalanceando os nos do caminho.
  *
  * @param bonsai tArvore* : endereco da arvore.
  * @param valor tDados: dados e ser inserido.
@@ -63,22 +193,20 @@ void criarArvore(tArvore *semente) {
  */
 tControle inserirArvore(tArvore *bonsai, tDados valor) {
 
-	auto tChave key = _hashA(valor.nome);
-	auto tArvore *aux = bonsai;
+	auto tNoArvore *novo;
 
-	while (*aux)
-		if ((*aux)->chave > key)
-			aux = &((*aux)->direita);
-		else
-			if((*aux)->chave < key)
-				aux = &((*aux)->esquerda);
-			else
-				return ERRO;
+	if (!(novo = (tArvore) malloc(sizeof(tNoArvore))))
+		return ERRO;
 
-	*aux = (tArvore) malloc(sizeof(tNoArvore));
-	(*aux)->direita = (*aux)->esquerda = NULL;
-	(*aux)->chave   = key;
-	(*aux)->dado    = valor;
+	novo->direita = novo->esquerda = NULL;
+	novo->altura  = 1;
+	novo->chave   = espalharPolinomial(valor.nome);
+	novo->dado    = valor;
+
+	if (_inserirNo(bonsai, novo) != SUCESSO) {
+		free(novo);
+		return ERRO;
+	}
 
 	return SUCESSO;
 }
@@ -90,26 +218,31 @@ tControle inserirArvore(tArvore *bonsai, tDados valor) {
  *  no parametro saida. Pode retornar true ou false.
  *
  * @param arvore tArvore : arvore que sera buscada.
- * @param string char* : elemento a ser buscado.
+ * @param string const char* : elemento a ser buscado.
  * @param saida tDados* : dados de saida.
  * @return SUCESSO ou ERRO se conseguiu encontrar ou nao.
  */
-tControle buscarArvore(tArvore arvore, char* string, tDados *saida) {
+tControle buscarArvore(tArvore arvore, const char* string, tDados *saida) {
+
+	auto tChave key;
+	auto int comparacao;
 
-	auto tChave key = _hashA(string);
+	MEDIR_INICIO(SUBSISTEMA_ARVORE);
+
+	key = espalharPolinomial(string);
 
 	while(arvore)
-		if (arvore->chave > key)
+		if ((comparacao = _compararNo(key, string, arvore)) < 0)
 			arvore = arvore->direita;
 		else
-			if (arvore->chave < key)
+			if (comparacao > 0)
 				arvore = arvore->esquerda;
 			else {
 				*saida = arvore->dado;
-				return SUCESSO;
+				return MEDIR_FIM_VALOR(SUCESSO);
 			}
 
-	return ERRO;
+	return MEDIR_FIM_VALOR(ERRO);
 }
 
 /**
@@ -131,24 +264,4 @@ void destruirArvore(tArvore *condenado) {
 	}
 }
 
-/**
- * Encontra o hash de uma palavra
- *
- * Faz a somatoria do valor ASCII de cada caracter da string que recebe multiplicado pela
- *  sua posicao na string. Funcao para uso interno. Retornara um inteiro de 54 bits.
- *
- * @param string char* : palavra de entrada
- * @return tChave : hash calculado
- */
-static tChave _hashA(char *string) {
-
-	auto tChave valor = 0;
-	register unsigned short int i = 0;
-
-	while(*string)
-		valor += (tChave) ((unsigned short int)(*string++) * ++i);
-
-	return valor;
-}
-
 #endif /* ARVORE_H_ */
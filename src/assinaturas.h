@@ -0,0 +1,174 @@
+/**
+ * Tabela de assinaturas de procedimentos.
+ *
+ * A assinatura de um procedimento eh a sequencia dos tipos dos seus parametros,
+ *  na ordem do fonte, escrita com um caracter por parametro (TIPO_INTEIRO ou
+ *  TIPO_REAL). Cada forma distinta eh guardada uma unica vez e identificada por
+ *  um numero, assim procedimentos com a mesma forma compartilham a assinatura e
+ *  a verificacao de uma chamada se resume a comparar dois numeros.
+ * As formas ficam em um bloco de caracteres e sao encontradas por um indice de
+ *  espalhamento (espalhamento).
+ *
+ * @see semantico
+ * @see espalhamento
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _ASSINATURAS_H_
+#define _ASSINATURAS_H_
+
+/*includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "espalhamento.h"
+
+/*defines*/
+#define TIPO_INTEIRO 'i' /*parametro inteiro na forma da assinatura*/
+#define TIPO_REAL 'r' /*parametro real na forma da assinatura*/
+#define NENHUMA_ASSINATURA ((unsigned int) -1) /*assinatura inexistente*/
+#define ASSINATURAS_INICIAIS 64 /*capacidade inicial do indice, potencia de dois*/
+#define TEXTO_ASSINATURAS_INICIAL 256 /*capacidade inicial do bloco de formas*/
+
+/*variaveis globais*/
+static char *formas; /**formas das assinaturas, cada uma terminada por '\0'*/
+static unsigned int tamanhoFormas; /**bytes ocupados no bloco de formas*/
+static unsigned int capacidadeFormas; /**bytes alocados no bloco de formas*/
+static unsigned int *inicioFormas; /**deslocamento da forma de cada assinatura*/
+static unsigned int capacidadeInicioFormas; /**deslocamentos alocados*/
+static unsigned int totalAssinaturas; /**numero de assinaturas*/
+static tIndice indiceAssinaturas; /**indice das formas, com o dobro de posicoes que assinaturas*/
+
+/*funcoes e procedimentos*/
+/**
+ * Espalhamento da forma de uma assinatura guardada. Funcao para uso interno.
+ *
+ * @param assinatura unsigned int : numero da assinatura.
+ * @return tChave : valor de espalhamento.
+ */
+static tChave _espalharAssinatura(unsigned int assinatura) {
+
+	return espalharCadeia(formas + inicioFormas[assinatura]);
+}
+
+/**
+ * Procura a posicao de uma forma na tabela. Funcao para uso interno.
+ *
+ * @param tipos const char* : forma.
+ * @param total unsigned int : numero de parametros.
+ * @return posicao da forma ou da primeira posicao vazia encontrada.
+ */
+static unsigned int _posicaoAssinatura(const char *tipos, unsigned int total) {
+
+	register unsigned int i = POSICAO_INDICE(&indiceAssinaturas, espalharBytes(tipos, total));
+	register const char *forma;
+
+	while (indiceAssinaturas.item[i]) {
+
+		forma = formas + inicioFormas[indiceAssinaturas.item[i] - 1];
+		if (!strncmp(forma, tipos, total) && !forma[total])
+			return i;
+
+		i = PROXIMA_POSICAO(&indiceAssinaturas, i);
+	}
+
+	return i;
+}
+
+/**
+ * Busca uma assinatura
+ *
+ * @param tipos const char* : forma, nao precisa terminar em '\0'.
+ * @param total unsigned int : numero de parametros.
+ * @return unsigned int : numero da assinatura ou NENHUMA_ASSINATURA se a forma
+ *          nunca foi guardada.
+ */
+unsigned int buscarAssinatura(const char *tipos, unsigned int total) {
+
+	if (!totalAssinaturas)
+		return NENHUMA_ASSINATURA;
+	if (!total) /*procedimento sem parametros pode vir sem vetor*/
+		tipos = "";
+
+	return indiceAssinaturas.item[_posicaoAssinatura(tipos, total)] - 1;
+}
+
+/**
+ * Guarda uma assinatura
+ *
+ * Se a forma ja foi guardada devolve o mesmo numero.
+ *
+ * @param tipos const char* : forma, nao precisa terminar em '\0'.
+ * @param total unsigned int : numero de parametros.
+ * @return unsigned int : numero da assinatura ou NENHUMA_ASSINATURA se faltar memoria.
+ */
+unsigned int internarAssinatura(const char *tipos, unsigned int total) {
+
+	auto unsigned int posicao;
+	auto unsigned int *inicios;
+	auto char *novas;
+
+	if (!total) /*procedimento sem parametros pode vir sem vetor*/
+		tipos = "";
+	if (2 * (totalAssinaturas + 1) > indiceAssinaturas.capacidade
+			&& crescerIndice(&indiceAssinaturas, ASSINATURAS_INICIAIS, totalAssinaturas,
+					_espalharAssinatura) != SUCESSO)
+		return NENHUMA_ASSINATURA;
+
+	posicao = _posicaoAssinatura(tipos, total);
+	if (indiceAssinaturas.item[posicao])
+		return indiceAssinaturas.item[posicao] - 1;
+
+	if (!(inicios = (unsigned int*) crescerVetor(inicioFormas, &capacidadeInicioFormas,
+			totalAssinaturas + 1, ASSINATURAS_INICIAIS / 2, sizeof(unsigned int))))
+		return NENHUMA_ASSINATURA;
+	inicioFormas = inicios;
+
+	if (!(novas = (char*) crescerVetor(formas, &capacidadeFormas, tamanhoFormas + total + 1,
+			TEXTO_ASSINATURAS_INICIAL, sizeof(char))))
+		return NENHUMA_ASSINATURA;
+	formas = novas;
+
+	memcpy(formas + tamanhoFormas, tipos, total);
+	formas[tamanhoFormas + total] = '\0';
+
+	inicioFormas[totalAssinaturas] = tamanhoFormas;
+	tamanhoFormas += total + 1;
+	indiceAssinaturas.item[posicao] = ++totalAssinaturas;
+
+	return totalAssinaturas - 1;
+}
+
+/**
+ * Forma de uma assinatura
+ *
+ * @param assinatura unsigned int : numero da assinatura.
+ * @return const char* : forma terminada em '\0', vazia se a assinatura nao existe.
+ */
+const char *formaAssinatura(unsigned int assinatura) {
+
+	return assinatura < totalAssinaturas ? formas + inicioFormas[assinatura] : "";
+}
+
+/**
+ * Destroi a tabela de assinaturas
+ *
+ * Desaloca o indice e o bloco de formas.
+ */
+void destruirAssinaturas(void) {
+
+	free(formas);
+	free(inicioFormas);
+	destruirIndice(&indiceAssinaturas);
+
+	formas = NULL;
+	inicioFormas = NULL;
+	tamanhoFormas = capacidadeFormas = capacidadeInicioFormas = totalAssinaturas = 0;
+}
+
+#endif /* _ASSINATURAS_H_ */
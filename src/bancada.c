@@ -0,0 +1,611 @@
+/**
+ * bancada.c
+ *
+ * Bancada de medicoes do compilador Equidnas (make bench).
+ *
+ * Mede nucleos isolados do compilador: a analise lexica de um fonte em memoria
+ *  e a entrega dos tokens por getToken, a insercao e a busca na arvore do escopo
+ *  global e na pilha do escopo local em varios tamanhos, a verificacao semantica
+ *  de identificadores (com os bytes copiados por token), a vazao do gecGeraCodigo,
+ *  os dois analisadores sintaticos sobre o mesmo programa, a compilacao completa
+ *  de um programa correto e de um cheio de erros (recuperacao do modo panico) e,
+ *  se houver um compilador C, o tempo de execucao de um programa gerado.
+ * Cada nucleo eh executado algumas vezes para aquecer caches e alocador, e essas
+ *  execucoes sao descartadas; das demais sao escritos a mediana, os percentis 90
+ *  e 99 e o minimo, em nanossegundos por unidade (token, chave, chamada ou
+ *  programa). Os programas medidos sao gerados aqui mesmo, com o mesmo texto a
+ *  cada execucao, entao os numeros podem ser comparados entre versoes.
+ * A compilacao completa usa a biblioteca (libequidnas.a); os demais nucleos
+ *  chamam diretamente os modulos, incluidos neste arquivo.
+ *
+ * Uso: bancada [prefixo], para medir apenas os nucleos cujo nome comeca pelo
+ *  prefixo.
+ *
+ * @see equidnas.h
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+/*clock_gettime e open_memstream (POSIX)*/
+#define _POSIX_C_SOURCE 200809L
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "padroes.h"
+#include "diagnosticos.h"
+#include "lexico.h"
+#include "sintatico.h"
+#include "semantico.h"
+#include "geradorCodigo.h"
+#include "sintaticoTabela.h"
+#include "equidnas.h"
+
+/*defines*/
+#define AQUECIMENTO 3 /*execucoes descartadas de cada nucleo*/
+#define REPETICOES 21 /*execucoes medidas de cada nucleo*/
+#define REPETICOES_PROGRAMA 5 /*execucoes medidas do programa gerado*/
+#define ARQUIVO_PROGRAMA "bancada_programa" /*programa gerado, sem a extensao*/
+
+/*novos tipos*/
+/**
+ * @brief Um nucleo medido.
+ *
+ * preparar monta o que o nucleo usa, fora da medicao, e devolve o numero de
+ *  unidades processadas por execucao, zero se o nucleo nao puder ser medido;
+ *  executar eh a parte medida; desfazer libera o que preparar montou.
+ */
+typedef struct {
+	const char *nome; /**nome do nucleo*/
+	const char *unidade; /**o que eh contado em cada execucao*/
+	unsigned int tamanho; /**parametro do nucleo, como o numero de chaves*/
+	unsigned int repeticoes; /**execucoes medidas*/
+	unsigned long (*preparar)(unsigned int); /**prepara o nucleo*/
+	void (*executar)(unsigned int); /**executa o nucleo uma vez*/
+	void (*desfazer)(void); /**libera o nucleo*/
+} tNucleo;
+
+/*variaveis globais*/
+static char *fonteBancada; /**programa em ALG usado pelo nucleo*/
+static size_t tamanhoFonteBancada; /**bytes do programa*/
+static tDados *chavesBancada; /**chaves das tabelas de simbolos*/
+static char (*nomesBancada)[24]; /**nomes das chaves, fora da tabela de nomes como os lexemas*/
+static tArvore arvoreBancada; /**arvore usada nas buscas*/
+static tPilhaHash pilhaBancada; /**pilha usada nas buscas*/
+static tToken *tokensBancada; /**identificadores verificados pelo analisador semantico*/
+
+/*funcoes e procedimentos*/
+/**
+ * Instante atual em nanossegundos. Funcao para uso interno.
+ *
+ * @return double : tempo de um relogio monotono.
+ */
+static double _instante(void) {
+
+	auto struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/**
+ * Gera um programa em ALG. Funcao para uso interno.
+ *
+ * Cada procedimento tem declaracoes, atribuicoes, se, enquanto e escreve, como
+ *  os programas de verdade. Com erros, cada procedimento recebe alguns erros
+ *  lexicos, sintaticos e semanticos, que o modo panico precisa atravessar.
+ *
+ * @param procedimentos unsigned int : numero de procedimentos.
+ * @param comErros signed char : diferente de zero para semear erros.
+ * @return char* : o programa, terminado em '\0', em fonteBancada.
+ */
+static char *_gerarPrograma(unsigned int procedimentos, signed char comErros) {
+
+	auto FILE *texto;
+	register unsigned int i, j;
+
+	if (!(texto = open_memstream(&fonteBancada, &tamanhoFonteBancada)))
+		return NULL;
+
+	fprintf(texto, "programa bancada;\nvar g1, g2 : inteiro;\nvar r1 : real;\n");
+
+	for (i = 0; i < procedimentos; ++i) {
+
+		fprintf(texto, "procedimento p%u(a, b : inteiro; x : real);\n"
+				"  var t, u : inteiro;\n  var w : real;\ninicio\n", i);
+
+		for (j = 0; j < 8; ++j)
+			fprintf(texto, "  t := a * %u + g1 - (u / 3);\n"
+					"  se t > %u entao inicio u := t; w := w + 1,5; fim senao u := 2;\n"
+					"  enquanto u < 10 faca u := u + 1;\n"
+					"  escreve(t, u);\n", j, j);
+
+		if (comErros)
+			fprintf(texto, "  t := a * ;\n  naoDeclarada := 1;\n  se t entao u := 1;\n"
+					"  u := t # 2;\n  t := 2,5;\n");
+
+		fprintf(texto, "  g2 := u + b;\nfim;\n");
+	}
+
+	fprintf(texto, "inicio\n  le(g1);\n");
+	for (i = 0; i < procedimentos; ++i)
+		fprintf(texto, "  p%u(g1, g2, r1);\n", i);
+	fprintf(texto, "  escreve(g2);\nfim.\n");
+
+	fclose(texto);
+	return fonteBancada;
+}
+
+/**
+ * Numero de tokens do programa gerado. Funcao para uso interno.
+ *
+ * @return unsigned long : tokens do programa em fonteBancada.
+ */
+static unsigned long _contarTokens(void) {
+
+	auto unsigned long total;
+
+	iniciarAnalisadorLexicoMemoria(fonteBancada, tamanhoFonteBancada);
+	total = fluxo.total;
+	fecharAnalisadorLexico();
+
+	return total;
+}
+
+/**
+ * Libera o programa gerado. Funcao para uso interno.
+ */
+static void _liberarPrograma(void) {
+
+	free(fonteBancada);
+	fonteBancada = NULL;
+}
+
+/*analise lexica*/
+static unsigned long _prepararLexico(unsigned int procedimentos) {
+
+	iniciarDiagnosticos("", 0, FORMATO_SILENCIOSO);
+	return _gerarPrograma(procedimentos, 0) ? _contarTokens() : 0;
+}
+
+static void _executarLexico(unsigned int procedimentos) {
+
+	iniciarAnalisadorLexicoMemoria(fonteBancada, tamanhoFonteBancada);
+	fecharAnalisadorLexico();
+}
+
+static void _desfazerLexico(void) {
+
+	_liberarPrograma();
+	fecharDiagnosticos();
+}
+
+/*entrega dos tokens*/
+static unsigned long _prepararGetToken(unsigned int procedimentos) {
+
+	auto unsigned long total = _prepararLexico(procedimentos);
+
+	iniciarAnalisadorLexicoMemoria(fonteBancada, tamanhoFonteBancada);
+	return total;
+}
+
+static void _executarGetToken(unsigned int procedimentos) {
+
+	auto tToken token;
+
+	irParaToken(0);
+	while (getToken(&token) == SUCESSO)
+		;
+}
+
+static void _desfazerGetToken(void) {
+
+	fecharAnalisadorLexico();
+	_desfazerLexico();
+}
+
+/**
+ * Monta as chaves das tabelas de simbolos. Funcao para uso interno.
+ *
+ * @param total unsigned int : numero de chaves.
+ * @param sequenciais signed char : diferente de zero para nomes em sequencia,
+ *         v0, v1, v2..., como os de programas gerados por outras ferramentas;
+ *         zero para nomes espalhados.
+ * @return unsigned long : numero de chaves, zero se faltar memoria.
+ */
+static unsigned long _montarChaves(unsigned int total, signed char sequenciais) {
+
+	register unsigned int i;
+
+	if (!(chavesBancada = (tDados*) calloc(total, sizeof(tDados)))
+			|| !(nomesBancada = (char (*)[24]) malloc(total * sizeof(*nomesBancada))))
+		return 0;
+
+	for (i = 0; i < total; ++i) {
+		if (sequenciais)
+			sprintf(nomesBancada[i], "v%u", i);
+		else
+			sprintf(nomesBancada[i], "variavel%u", i * 7919u);
+		if (!(chavesBancada[i].nome = internarNome(nomesBancada[i])))
+			return 0;
+		chavesBancada[i].tipo = i % 2 ? INTEIRO : REAL;
+	}
+
+	criarArvore(&arvoreBancada);
+	criarPilha(&pilhaBancada);
+	return total;
+}
+
+/*tabelas de simbolos*/
+static unsigned long _prepararChaves(unsigned int total) {
+
+	return _montarChaves(total, 0);
+}
+
+static unsigned long _prepararChavesSequenciais(unsigned int total) {
+
+	return _montarChaves(total, 1);
+}
+
+static void _desfazerChaves(void) {
+
+	destruirArvore(&arvoreBancada);
+	destruirPilha(&pilhaBancada);
+	destruirNomes();
+	free(chavesBancada);
+	free(nomesBancada);
+	chavesBancada = NULL;
+	nomesBancada = NULL;
+}
+
+/*insercao na arvore, com a destruicao da arvore montada*/
+static void _executarInsercaoArvore(unsigned int total) {
+
+	register unsigned int i;
+
+	for (i = 0; i < total; ++i)
+		inserirArvore(&arvoreBancada, chavesBancada[i]);
+	destruirArvore(&arvoreBancada);
+}
+
+static unsigned long _prepararBuscaArvore(unsigned int total) {
+
+	register unsigned int i;
+
+	if (!_prepararChaves(total))
+		return 0;
+
+	for (i = 0; i < total; ++i)
+		inserirArvore(&arvoreBancada, chavesBancada[i]);
+	return total;
+}
+
+static unsigned long _prepararBuscaArvoreSequencial(unsigned int total) {
+
+	register unsigned int i;
+
+	if (!_prepararChavesSequenciais(total))
+		return 0;
+
+	for (i = 0; i < total; ++i)
+		inserirArvore(&arvoreBancada, chavesBancada[i]);
+	return total;
+}
+
+static void _executarBuscaArvore(unsigned int total) {
+
+	auto tDados dados;
+	register unsigned int i;
+
+	for (i = 0; i < total; ++i)
+		buscarArvore(arvoreBancada, nomesBancada[i], &dados);
+}
+
+/*insercao na pilha, com a destruicao da pilha montada*/
+static void _executarInsercaoPilha(unsigned int total) {
+
+	register unsigned int i;
+
+	for (i = 0; i < total; ++i)
+		inserirPilha(&pilhaBancada, chavesBancada + i);
+	destruirPilha(&pilhaBancada);
+}
+
+static unsigned long _prepararBuscaPilha(unsigned int total) {
+
+	register unsigned int i;
+
+	if (!_prepararChaves(total))
+		return 0;
+
+	for (i = 0; i < total; ++i)
+		inserirPilha(&pilhaBancada, chavesBancada + i);
+	return total;
+}
+
+static void _executarBuscaPilha(unsigned int total) {
+
+	auto tDados dados;
+	register unsigned int i;
+
+	for (i = 0; i < total; ++i)
+		buscarPilha(&pilhaBancada, nomesBancada[i], &dados);
+}
+
+/*verificacao semantica de identificadores declarados no escopo global*/
+static unsigned long _prepararSemantico(unsigned int total) {
+
+	register unsigned int i;
+
+	analisadorSemantico();
+
+	if (!_prepararChaves(total) || !(tokensBancada = (tToken*) malloc(total * sizeof(tToken))))
+		return 0;
+
+	for (i = 0; i < total; ++i) {
+		inserirArvore(&escopoGlobal, chavesBancada[i]);
+		tokensBancada[i].cadeia = nomesBancada[i];
+		tokensBancada[i].signo = IDENTIFICADOR;
+		tokensBancada[i].linha = 1;
+	}
+	return total;
+}
+
+static void _executarSemantico(unsigned int total) {
+
+	register unsigned int i;
+
+	for (i = 0; i < total; ++i)
+		semVerDeclVar(tokensBancada + i);
+}
+
+static void _desfazerSemantico(void) {
+
+	fecharSemantico();
+	_desfazerChaves();
+	free(tokensBancada);
+	tokensBancada = NULL;
+}
+
+/*vazao do gerador, em um bloco de memoria*/
+static unsigned long _prepararGerador(unsigned int total) {
+
+	contErros = 0;
+	return total;
+}
+
+static void _executarGerador(unsigned int total) {
+
+	auto char *codigo = NULL;
+	auto size_t tamanho;
+	register unsigned int i;
+
+	if (geradorMemoria(&codigo, &tamanho) != SUCESSO)
+		return;
+
+	for (i = 0; i < total; ++i)
+		gecGeraCodigo("\nt = a * 3 + g1;");
+
+	fecharGerador();
+	free(codigo);
+}
+
+static void _desfazerNada(void) {
+}
+
+/*analisador dirigido por tabela, apenas a sintaxe*/
+static void _executarTabela(unsigned int procedimentos) {
+
+	irParaToken(0);
+	analiseSintaticaTabela();
+}
+
+/*analisador descendente recursivo, com a semantica e sem escrever o codigo*/
+static void _executarDescendente(unsigned int procedimentos) {
+
+	auto char *codigo = NULL;
+	auto size_t tamanho;
+
+	iniciarOtimizador(1);
+	iniciarExpansao(0);
+	iniciarParalelo(1);
+
+	irParaToken(0);
+	analisadorSemantico();
+	if (geradorMemoria(&codigo, &tamanho) == SUCESSO) {
+
+		gecSuspender(1);
+		analiseSintatica();
+		fecharGerador();
+	}
+	fecharSemantico();
+	fecharExpansao();
+	free(codigo);
+}
+
+/*compilacao completa pela biblioteca*/
+static unsigned long _prepararCompilacao(unsigned int procedimentos) {
+
+	iniciarDiagnosticos("", 0, FORMATO_SILENCIOSO);
+	return _gerarPrograma(procedimentos, 0) ? _contarTokens() : 0;
+}
+
+static unsigned long _prepararRecuperacao(unsigned int procedimentos) {
+
+	iniciarDiagnosticos("", 0, FORMATO_SILENCIOSO);
+	return _gerarPrograma(procedimentos, 1) ? _contarTokens() : 0;
+}
+
+static void _executarCompilacao(unsigned int procedimentos) {
+
+	auto tResultadoEquidnas resultado;
+
+	equidnasCompilar(fonteBancada, tamanhoFonteBancada, NULL, &resultado);
+	equidnasLiberar(&resultado);
+}
+
+/*programa gerado, compilado pelo compilador C do sistema*/
+static unsigned long _prepararPrograma(unsigned int voltas) {
+
+	static const char *laco = "programa laco;\nvar i, s : inteiro;\nvar x : real;\n"
+			"procedimento passo(k : inteiro);\ninicio\n  s := (s + k * 3) / 2;\n"
+			"  x := x + 0,5;\nfim;\ninicio\n  i := 0;\n  enquanto i < %u faca\n"
+			"  inicio\n    passo(i);\n    i := i + 1;\n  fim;\n  escreve(s);\nfim.\n";
+	auto char fonte[512];
+	auto tResultadoEquidnas resultado;
+	auto FILE *arquivo;
+	auto signed char pronto = 0;
+
+	sprintf(fonte, laco, voltas);
+
+	if (equidnasCompilar(fonte, strlen(fonte), NULL, &resultado) == EQUIDNAS_SUCESSO
+			&& (arquivo = fopen(ARQUIVO_PROGRAMA ".c", "wb"))) {
+
+		fwrite(resultado.codigo, 1, resultado.tamanhoCodigo, arquivo);
+		pronto = !fclose(arquivo) && !system("cc -O2 -w -o " ARQUIVO_PROGRAMA " "
+				ARQUIVO_PROGRAMA ".c");
+	}
+	equidnasLiberar(&resultado);
+
+	return pronto;
+}
+
+static void _executarPrograma(unsigned int voltas) {
+
+	if (system("./" ARQUIVO_PROGRAMA " > /dev/null"))
+		fprintf(stderr, "O programa gerado terminou com erro\n");
+}
+
+static void _desfazerPrograma(void) {
+
+	remove(ARQUIVO_PROGRAMA ".c");
+	remove(ARQUIVO_PROGRAMA);
+}
+
+/*nucleos medidos*/
+static const tNucleo nucleos[] = {
+	{ "lexico_analise", "token", 10, REPETICOES, _prepararLexico, _executarLexico, _desfazerLexico },
+	{ "lexico_analise", "token", 1000, REPETICOES, _prepararLexico, _executarLexico, _desfazerLexico },
+	{ "lexico_getToken", "token", 10, REPETICOES, _prepararGetToken, _executarGetToken, _desfazerGetToken },
+	{ "lexico_getToken", "token", 1000, REPETICOES, _prepararGetToken, _executarGetToken, _desfazerGetToken },
+	{ "arvore_insercao", "chave", 100, REPETICOES, _prepararChaves, _executarInsercaoArvore, _desfazerChaves },
+	{ "arvore_insercao", "chave", 1000, REPETICOES, _prepararChaves, _executarInsercaoArvore, _desfazerChaves },
+	{ "arvore_insercao", "chave", 10000, REPETICOES, _prepararChaves, _executarInsercaoArvore, _desfazerChaves },
+	{ "arvore_busca", "chave", 100, REPETICOES, _prepararBuscaArvore, _executarBuscaArvore, _desfazerChaves },
+	{ "arvore_busca", "chave", 1000, REPETICOES, _prepararBuscaArvore, _executarBuscaArvore, _desfazerChaves },
+	{ "arvore_busca", "chave", 10000, REPETICOES, _prepararBuscaArvore, _executarBuscaArvore, _desfazerChaves },
+	{ "arvore_insercao_seq", "chave", 1000, REPETICOES, _prepararChavesSequenciais, _executarInsercaoArvore, _desfazerChaves },
+	{ "arvore_insercao_seq", "chave", 100000, REPETICOES, _prepararChavesSequenciais, _executarInsercaoArvore, _desfazerChaves },
+	{ "arvore_busca_seq", "chave", 1000, REPETICOES, _prepararBuscaArvoreSequencial, _executarBuscaArvore, _desfazerChaves },
+	{ "arvore_busca_seq", "chave", 100000, REPETICOES, _prepararBuscaArvoreSequencial, _executarBuscaArvore, _desfazerChaves },
+	{ "pilha_insercao", "chave", 10, REPETICOES, _prepararChaves, _executarInsercaoPilha, _desfazerChaves },
+	{ "pilha_insercao", "chave", 100, REPETICOES, _prepararChaves, _executarInsercaoPilha, _desfazerChaves },
+	{ "pilha_insercao", "chave", 1000, REPETICOES, _prepararChaves, _executarInsercaoPilha, _desfazerChaves },
+	{ "pilha_busca", "chave", 10, REPETICOES, _prepararBuscaPilha, _executarBuscaPilha, _desfazerChaves },
+	{ "pilha_busca", "chave", 100, REPETICOES, _prepararBuscaPilha, _executarBuscaPilha, _desfazerChaves },
+	{ "pilha_busca", "chave", 1000, REPETICOES, _prepararBuscaPilha, _executarBuscaPilha, _desfazerChaves },
+	{ "gerador_gecGeraCodigo", "chamada", 100000, REPETICOES, _prepararGerador, _executarGerador, _desfazerNada },
+	{ "semantico_verDeclVar", "token", 1000, REPETICOES, _prepararSemantico, _executarSemantico, _desfazerSemantico },
+	{ "semantico_verDeclVar", "token", 10000, REPETICOES, _prepararSemantico, _executarSemantico, _desfazerSemantico },
+	{ "sintatico_tabela", "token", 200, REPETICOES, _prepararGetToken, _executarTabela, _desfazerGetToken },
+	{ "sintatico_descendente", "token", 200, REPETICOES, _prepararGetToken, _executarDescendente, _desfazerGetToken },
+	{ "compilacao", "token", 200, REPETICOES, _prepararCompilacao, _executarCompilacao, _desfazerLexico },
+	{ "recuperacao_erros", "token", 200, REPETICOES, _prepararRecuperacao, _executarCompilacao, _desfazerLexico },
+	{ "programa_gerado", "programa", 20000000, REPETICOES_PROGRAMA, _prepararPrograma, _executarPrograma, _desfazerPrograma }
+};
+
+/**
+ * Compara duas amostras para qsort. Funcao para uso interno.
+ */
+static int _compararAmostras(const void *a, const void *b) {
+
+	auto double x = *(const double*) a, y = *(const double*) b;
+
+	return x < y ? -1 : x > y;
+}
+
+/**
+ * Percentil de amostras ordenadas, pela posicao mais proxima. Funcao para uso
+ *  interno.
+ *
+ * @param amostras const double* : amostras em ordem crescente.
+ * @param total unsigned int : numero de amostras.
+ * @param percentil unsigned int : de 1 a 100.
+ * @return double : a amostra do percentil.
+ */
+static double _percentil(const double *amostras, unsigned int total, unsigned int percentil) {
+
+	auto unsigned int posicao = (percentil * total + 99) / 100;
+
+	return amostras[posicao ? posicao - 1 : 0];
+}
+
+/**
+ * Mede um nucleo e escreve uma linha com os resultados. Funcao para uso interno.
+ *
+ * @param nucleo const tNucleo* : nucleo a medir.
+ */
+static void _medir(const tNucleo *nucleo) {
+
+	auto double amostras[REPETICOES], inicio;
+	auto unsigned long unidades;
+	register unsigned int i;
+
+	if (!(unidades = nucleo->preparar(nucleo->tamanho))) {
+		nucleo->desfazer();
+		printf("%-24s %10u %-9s %12s\n", nucleo->nome, nucleo->tamanho, nucleo->unidade,
+				"indisponivel");
+		return;
+	}
+
+	for (i = 0; i < AQUECIMENTO; ++i)
+		nucleo->executar(nucleo->tamanho);
+
+	for (i = 0; i < nucleo->repeticoes; ++i) {
+		inicio = _instante();
+		nucleo->executar(nucleo->tamanho);
+		amostras[i] = (_instante() - inicio) / unidades;
+	}
+
+	nucleo->desfazer();
+
+	qsort(amostras, nucleo->repeticoes, sizeof(double), _compararAmostras);
+
+	printf("%-24s %10u %-9s %12.2f %12.2f %12.2f %12.2f\n", nucleo->nome, nucleo->tamanho,
+			nucleo->unidade, _percentil(amostras, nucleo->repeticoes, 50),
+			_percentil(amostras, nucleo->repeticoes, 90),
+			_percentil(amostras, nucleo->repeticoes, 99), amostras[0]);
+	fflush(stdout);
+}
+
+/*programa principal*/
+/**
+ * Mede os nucleos cujo nome comeca pelo prefixo dado, ou todos.
+ */
+int main(int argc, char *argv[]) {
+
+	auto signed char semantico = 0;
+	register unsigned int i;
+
+	printf("%-24s %10s %-9s %12s %12s %12s %12s\n", "nucleo", "tamanho", "unidade",
+			"mediana_ns", "p90_ns", "p99_ns", "minimo_ns");
+
+	for (i = 0; i < sizeof(nucleos) / sizeof(tNucleo); ++i)
+		if (argc < 2 || !strncmp(nucleos[i].nome, argv[1], strlen(argv[1]))) {
+			_medir(nucleos + i);
+			semantico |= nucleos[i].executar == _executarSemantico;
+		}
+
+	/*as verificacoes recebem o token por referencia, antes ele era copiado*/
+	if (semantico)
+		printf("\n# semantico: %u bytes copiados por token verificado (const tToken*), "
+				"contra %u do tToken por valor\n", (unsigned int) sizeof(const tToken*),
+				(unsigned int) sizeof(tToken));
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * biblioteca.c
+ *
+ * Biblioteca do compilador Equidnas.
+ *
+ * Reune os mesmos modulos do programa equidnas, mas em vez do main oferece a
+ *  interface de equidnas.h: o fonte vem de um bloco de memoria (lexico), o
+ *  codigo eh escrito em outro bloco (geradorCodigo, com open_memstream) e os
+ *  diagnosticos sao copiados do vetor guardado durante a analise, sem nada ser
+ *  escrito na saida padrao. A compilacao paralela e a incremental, que usam
+ *  arquivos, ficam de fora.
+ * Ao montar libequidnas.a apenas as funcoes de equidnas.h continuam globais
+ *  (Makefile), assim os nomes internos nao colidem com os de quem usa.
+ *
+ * @see equidnas.h
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+/*fork, waitpid e _exit da compilacao paralela, open_memstream do gerador em
+ * memoria (POSIX)*/
+#define _POSIX_C_SOURCE 200809L
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "diagnosticos.h"
+#include "lexico.h"
+#include "sintatico.h"
+#include "semantico.h"
+#include "geradorCodigo.h"
+#include "incremental.h"
+#include "paralelo.h"
+#include "equidnas.h"
+
+/*funcoes e procedimentos*/
+/**
+ * Preenche as opcoes com os valores da linha de comando sem opcoes.
+ *
+ * @param opcoes tOpcoesEquidnas* : opcoes a preencher.
+ */
+void equidnasOpcoesPadrao(tOpcoesEquidnas *opcoes) {
+
+	opcoes->maxErros = 0;
+	opcoes->limiteExpansao = LIMITE_EXPANSAO_PADRAO;
+	opcoes->semOtimizacao = 0;
+}
+
+/**
+ * Situacao da compilacao a partir do resultado da analise. Funcao para uso
+ *  interno.
+ *
+ * @param erro tControle : resultado da analise sintatica.
+ * @return int : situacao de equidnas.h.
+ */
+static int _situacao(tControle erro) {
+
+	switch (erro) {
+	case SUCESSO:
+		return EQUIDNAS_SUCESSO;
+	case FIM_ARQ_PREMATURO:
+		return EQUIDNAS_FIM_INESPERADO;
+	case ERRO:
+		return EQUIDNAS_ERROS;
+	default:
+		return EQUIDNAS_VAZIO;
+	}
+}
+
+/**
+ * Compila um programa ALG
+ *
+ * @param fonte const char* : codigo-fonte, nao precisa terminar em '\0'.
+ * @param tamanho size_t : numero de bytes do codigo-fonte.
+ * @param opcoes const tOpcoesEquidnas* : opcoes, NULL para as padrao.
+ * @param resultado tResultadoEquidnas* : recebe o resultado, que deve ser
+ *         liberado com equidnasLiberar.
+ * @return int : a situacao da compilacao, tambem guardada no resultado.
+ */
+int equidnasCompilar(const char *fonte, size_t tamanho, const tOpcoesEquidnas *opcoes,
+		tResultadoEquidnas *resultado) {
+
+	auto tOpcoesEquidnas padrao;
+	auto const tDiagnostico *guardados;
+	auto char *codigo = NULL;
+	auto size_t tamanhoCodigo = 0;
+	auto tControle erro;
+	auto unsigned int total;
+	register unsigned int i;
+
+	memset(resultado, 0, sizeof(tResultadoEquidnas));
+
+	if (!opcoes) {
+		equidnasOpcoesPadrao(&padrao);
+		opcoes = &padrao;
+	}
+
+	/*as opcoes ficam em variaveis globais, que podem ter mudado desde a ultima chamada*/
+	iniciarOtimizador(!opcoes->semOtimizacao);
+	iniciarExpansao(opcoes->limiteExpansao);
+	iniciarParalelo(1);
+
+	if (iniciarAnalisadorLexicoMemoria(fonte, tamanho) != SUCESSO) {
+		fecharAnalisadorLexico();
+		return resultado->situacao = EQUIDNAS_SEM_MEMORIA;
+	}
+
+	iniciarDiagnosticos("", opcoes->maxErros, FORMATO_SILENCIOSO);
+	analisadorSemantico();
+
+	if (geradorMemoria(&codigo, &tamanhoCodigo) != SUCESSO) {
+		fecharAnalisadorLexico();
+		fecharSemantico();
+		fecharDiagnosticos();
+		return resultado->situacao = EQUIDNAS_SEM_MEMORIA;
+	}
+
+	erro = analiseSintatica();
+
+	fecharAnalisadorLexico();
+	fecharSemantico();
+	fecharExpansao();
+	fecharGerador();
+
+	/*as mensagens sao constantes, apenas os ponteiros sao copiados*/
+	guardados = obterDiagnosticos(&total);
+	if (total && (resultado->diagnosticos = (tDiagnosticoEquidnas*)
+			malloc(total * sizeof(tDiagnosticoEquidnas)))) {
+
+		for (i = 0; i < total; ++i) {
+			resultado->diagnosticos[i].mensagem = guardados[i].mensagem;
+			resultado->diagnosticos[i].linha = guardados[i].linha;
+			resultado->diagnosticos[i].coluna = guardados[i].coluna;
+		}
+		resultado->totalDiagnosticos = total;
+	}
+	fecharDiagnosticos();
+
+	if (erro == SUCESSO && codigo) {
+		resultado->codigo = codigo;
+		resultado->tamanhoCodigo = tamanhoCodigo;
+	}
+	else
+		free(codigo);
+
+	return resultado->situacao = _situacao(erro);
+}
+
+/**
+ * Libera o codigo e os diagnosticos de um resultado.
+ *
+ * @param resultado tResultadoEquidnas* : resultado de equidnasCompilar.
+ */
+void equidnasLiberar(tResultadoEquidnas *resultado) {
+
+	free(resultado->codigo);
+	free(resultado->diagnosticos);
+
+	resultado->codigo = NULL;
+	resultado->diagnosticos = NULL;
+	resultado->tamanhoCodigo = 0;
+	resultado->totalDiagnosticos = 0;
+}
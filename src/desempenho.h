@@ -0,0 +1,231 @@
+/**
+ * desempenho.h
+ *
+ * Contadores de desempenho do processador por subsistema do compilador.
+ *
+ * Compilado com EQUIDNAS_CONTADORES (make CONTADORES=1), o compilador abre com
+ *  perf_event_open (Linux) um grupo de contadores de ciclos, instrucoes, desvios
+ *  mal previstos e falhas de cache, contando apenas o codigo do usuario. Na
+ *  entrada e na saida de getToken, buscarArvore, buscarPilha e das funcoes do
+ *  gerador o grupo eh lido e a diferenca desde a leitura anterior vai para o
+ *  subsistema em execucao: como as chamadas podem se aninhar (o gerador consulta
+ *  a pilha, por exemplo), cada subsistema fica apenas com o que foi gasto nele
+ *  mesmo, e o tempo fora de todos vai para "outros". Os totais sao escritos na
+ *  saida de erros ao final da compilacao.
+ * Cada leitura eh uma chamada ao sistema, entao a compilacao fica bem mais
+ *  lenta; as comparacoes valem entre duas compilacoes medidas. Na compilacao
+ *  paralela apenas o processo principal eh medido.
+ * Sem EQUIDNAS_CONTADORES as marcacoes nao geram codigo.
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _DESEMPENHO_H_
+#define _DESEMPENHO_H_
+
+/*subsistemas medidos*/
+#define SUBSISTEMA_OUTROS 0 /*tudo o que nao esta nos demais*/
+#define SUBSISTEMA_LEXICO 1 /*getToken*/
+#define SUBSISTEMA_ARVORE 2 /*buscarArvore, escopo global*/
+#define SUBSISTEMA_PILHA 3 /*buscarPilha, escopo local*/
+#define SUBSISTEMA_GERADOR 4 /*funcoes gec do gerador de codigo*/
+#define TOTAL_SUBSISTEMAS 5
+
+#ifdef EQUIDNAS_CONTADORES
+
+/*includes*/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
+
+/*defines*/
+#define TOTAL_CONTADORES 4 /*ciclos, instrucoes, desvios mal previstos e falhas de cache*/
+#define PROFUNDIDADE_MEDICAO 64 /*aninhamento maximo de subsistemas medidos*/
+
+/*marcacoes*/
+#define MEDIR_INICIO(subsistema) medirEntrada(subsistema)
+#define MEDIR_FIM() medirSaida()
+#define MEDIR_FIM_VALOR(valor) medirSaidaValor(valor)
+
+/*variaveis globais*/
+static int lider = -1; /**descritor do primeiro contador do grupo, -1 sem medicao*/
+static int descritores[TOTAL_CONTADORES]; /**descritores dos contadores abertos*/
+static signed char presentes[TOTAL_CONTADORES]; /**contadores que puderam ser abertos*/
+static unsigned int abertos; /**numero de contadores no grupo*/
+static unsigned long ultimaLeitura[TOTAL_CONTADORES]; /**valores na leitura anterior*/
+static unsigned long totaisSubsistema[TOTAL_SUBSISTEMAS][TOTAL_CONTADORES]; /**gasto de cada subsistema*/
+static unsigned long chamadasSubsistema[TOTAL_SUBSISTEMAS]; /**entradas em cada subsistema*/
+static unsigned int pilhaSubsistemas[PROFUNDIDADE_MEDICAO]; /**subsistemas em execucao*/
+static unsigned int profundidade; /**numero de subsistemas em execucao*/
+
+/*funcoes e procedimentos*/
+/**
+ * Le o grupo e acumula a diferenca no subsistema em execucao. Funcao para uso
+ *  interno.
+ */
+static void _acumularMedicao(void) {
+
+	auto __u64 leitura[TOTAL_CONTADORES + 1]; /*formato do kernel, 64 bits por valor*/
+	auto unsigned int atual;
+	register unsigned int i, j;
+
+	if (read(lider, leitura, sizeof(leitura)) < (ssize_t) ((abertos + 1) * sizeof(__u64)))
+		return;
+
+	atual = profundidade ? pilhaSubsistemas[(profundidade > PROFUNDIDADE_MEDICAO
+			? PROFUNDIDADE_MEDICAO : profundidade) - 1] : SUBSISTEMA_OUTROS;
+
+	/*a leitura traz o numero de contadores e seus valores, na ordem da abertura*/
+	for (i = j = 0; i < TOTAL_CONTADORES; ++i)
+		if (presentes[i]) {
+			totaisSubsistema[atual][i] += (unsigned long) leitura[1 + j] - ultimaLeitura[i];
+			ultimaLeitura[i] = (unsigned long) leitura[1 + j++];
+		}
+}
+
+/**
+ * Abre os contadores.
+ *
+ * Os contadores que o processador ou o sistema nao oferecem ficam de fora; sem
+ *  nenhum a compilacao segue sem medicao.
+ */
+void iniciarContadores(void) {
+
+	static const __u64 configuracoes[TOTAL_CONTADORES] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+	};
+	auto struct perf_event_attr atributos;
+	auto int descritor;
+	register unsigned int i;
+
+	for (i = 0; i < TOTAL_CONTADORES; ++i) {
+
+		memset(&atributos, 0, sizeof(atributos));
+		atributos.type = PERF_TYPE_HARDWARE;
+		atributos.size = sizeof(atributos);
+		atributos.config = configuracoes[i];
+		atributos.read_format = PERF_FORMAT_GROUP;
+		atributos.disabled = lider < 0;
+		atributos.exclude_kernel = 1;
+		atributos.exclude_hv = 1;
+
+		descritor = (int) syscall(SYS_perf_event_open, &atributos, 0, -1, lider, 0);
+		if (descritor < 0)
+			continue;
+
+		if (lider < 0)
+			lider = descritor;
+		descritores[i] = descritor;
+		presentes[i] = 1;
+		++abertos;
+	}
+
+	if (lider < 0) {
+		fprintf(stderr, "Contadores de desempenho indisponiveis\n");
+		return;
+	}
+
+	ioctl(lider, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(lider, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+/**
+ * Marca a entrada em um subsistema.
+ *
+ * @param subsistema unsigned int : SUBSISTEMA_LEXICO, SUBSISTEMA_ARVORE, ...
+ */
+void medirEntrada(unsigned int subsistema) {
+
+	if (lider < 0)
+		return;
+
+	_acumularMedicao();
+
+	if (profundidade < PROFUNDIDADE_MEDICAO)
+		pilhaSubsistemas[profundidade] = subsistema;
+	++profundidade;
+	++chamadasSubsistema[subsistema];
+}
+
+/**
+ * Marca a saida do subsistema em execucao.
+ */
+void medirSaida(void) {
+
+	if (lider < 0 || !profundidade)
+		return;
+
+	_acumularMedicao();
+	--profundidade;
+}
+
+/**
+ * Marca a saida do subsistema em execucao, para o uso em um return.
+ *
+ * @param valor int : valor devolvido pela funcao medida.
+ * @return int : o proprio valor.
+ */
+int medirSaidaValor(int valor) {
+
+	medirSaida();
+	return valor;
+}
+
+/**
+ * Fecha os contadores e escreve os totais de cada subsistema.
+ */
+void fecharContadores(void) {
+
+	static const char *nomes[TOTAL_SUBSISTEMAS] = {
+		"outros", "lexico", "arvore", "pilha", "gerador"
+	};
+	static const char *contadores[TOTAL_CONTADORES] = {
+		"ciclos", "instrucoes", "desvios_errados", "falhas_cache"
+	};
+	register unsigned int i, j;
+
+	if (lider < 0)
+		return;
+
+	_acumularMedicao();
+	for (i = 0; i < TOTAL_CONTADORES; ++i)
+		if (presentes[i])
+			close(descritores[i]);
+	lider = -1;
+
+	fprintf(stderr, "\n%-10s %12s", "subsistema", "chamadas");
+	for (j = 0; j < TOTAL_CONTADORES; ++j)
+		fprintf(stderr, " %16s", contadores[j]);
+	fprintf(stderr, "\n");
+
+	for (i = 0; i < TOTAL_SUBSISTEMAS; ++i) {
+
+		fprintf(stderr, "%-10s %12lu", nomes[i], chamadasSubsistema[i]);
+		for (j = 0; j < TOTAL_CONTADORES; ++j)
+			if (presentes[j])
+				fprintf(stderr, " %16lu", totaisSubsistema[i][j]);
+			else
+				fprintf(stderr, " %16s", "-");
+		fprintf(stderr, "\n");
+	}
+}
+
+#else
+
+/*sem os contadores as marcacoes desaparecem*/
+#define MEDIR_INICIO(subsistema)
+#define MEDIR_FIM()
+#define MEDIR_FIM_VALOR(valor) (valor)
+#define iniciarContadores()
+#define fecharContadores()
+
+#endif /* EQUIDNAS_CONTADORES */
+
+#endif /* _DESEMPENHO_H_ */
@@ -0,0 +1,240 @@
+/**
+ * diagnosticos.h
+ *
+ * Guarda as mensagens de erro da compilacao em um vetor na memoria, em vez
+ *  de escreve-las uma a uma na saida padrao. Cada diagnostico leva a linha e a
+ *  coluna do token em que foi detectado. Ao final da compilacao o vetor eh
+ *  escrito de uma vez, como texto ou como JSON.
+ * Pode haver um limite de erros, ao atingi-lo a analise eh interrompida.
+ *
+ * @see sintatico
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _DIAGNOSTICOS_H_
+#define _DIAGNOSTICOS_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "padroes.h"
+#include "vetor.h"
+
+/*defines*/
+#define DIAGNOSTICOS_INICIAIS 64 /*capacidade inicial do vetor de diagnosticos*/
+
+/*formatos de saida dos diagnosticos*/
+#define FORMATO_TEXTO 0
+#define FORMATO_JSON 1
+#define FORMATO_SILENCIOSO 2 /*nada eh escrito, os diagnosticos sao lidos por obterDiagnosticos*/
+
+/*novos tipos*/
+/**
+ * @brief Um diagnostico.
+ *
+ * Mensagem de erro e a posicao no codigo-fonte onde foi encontrada. As mensagens
+ *  sao constantes do compilador, entao apenas o ponteiro eh guardado.
+ */
+typedef struct {
+	const char *mensagem; /**texto do erro*/
+	unsigned int linha; /**linha do token onde o erro foi detectado*/
+	unsigned int coluna; /**coluna do token onde o erro foi detectado*/
+} tDiagnostico;
+
+/*variaveis globais*/
+static tDiagnostico *diagnosticos; /**vetor de diagnosticos*/
+static unsigned int totalDiagnosticos; /**numero de diagnosticos guardados*/
+static unsigned int capacidadeDiagnosticos; /**numero de diagnosticos alocados*/
+static unsigned int maxErros; /**limite de erros, zero para nao haver limite*/
+static signed char formatoDiagnosticos; /**FORMATO_TEXTO, FORMATO_JSON ou FORMATO_SILENCIOSO*/
+static const char *arqDiagnosticos; /**nome do arquivo origem, para os diagnosticos*/
+static FILE *saidaDiagnosticos; /**onde os diagnosticos sao escritos, normalmente a saida padrao*/
+
+/*funcoes e procedimentos*/
+/**
+ * Inicializa os diagnosticos.
+ *
+ * @param nomeArquivo const char* : nome do arquivo origem.
+ * @param limite unsigned int : numero maximo de erros, zero para nao haver limite.
+ * @param formato signed char : FORMATO_TEXTO, FORMATO_JSON ou FORMATO_SILENCIOSO.
+ */
+void iniciarDiagnosticos(const char *nomeArquivo, unsigned int limite, signed char formato) {
+
+	arqDiagnosticos = nomeArquivo;
+	saidaDiagnosticos = stdout;
+	maxErros = limite;
+	formatoDiagnosticos = formato;
+
+	diagnosticos = NULL;
+	totalDiagnosticos = capacidadeDiagnosticos = 0;
+}
+
+/**
+ * Desvia os diagnosticos.
+ *
+ * Quando o codigo gerado vai para a saida padrao os diagnosticos precisam ir
+ *  para outro lugar, como a saida de erros, para nao se misturarem ao codigo.
+ *
+ * @param saida FILE* : arquivo que recebera os diagnosticos.
+ */
+void desviarDiagnosticos(FILE *saida) {
+
+	saidaDiagnosticos = saida;
+}
+
+/**
+ * Verifica o limite de erros.
+ *
+ * @return diferente de zero se o limite de erros foi atingido.
+ */
+int limiteDeErrosAtingido(void) {
+
+	return maxErros && totalDiagnosticos >= maxErros;
+}
+
+/**
+ * Interrompe a analise.
+ *
+ * O limite de erros passa a ser o numero de diagnosticos ja guardados, assim a
+ *  analise termina pelo mesmo caminho de quando o limite eh atingido.
+ */
+void interromperAnalise(void) {
+
+	maxErros = totalDiagnosticos ? totalDiagnosticos : 1;
+}
+
+/**
+ * Guarda um diagnostico.
+ *
+ * Coloca o diagnostico no final do vetor, que cresce dobrando de tamanho. Depois
+ *  de atingido o limite de erros nada mais eh guardado.
+ *
+ * @param mensagem const char* : texto do erro.
+ * @param linha unsigned int : linha do erro.
+ * @param coluna unsigned int : coluna do erro.
+ * @return SUCESSO se guardou, ERRO se o limite ja foi atingido ou faltou memoria.
+ */
+tControle registrarDiagnostico(const char *mensagem, unsigned int linha, unsigned int coluna) {
+
+	auto tDiagnostico *novo;
+
+	if (limiteDeErrosAtingido())
+		return ERRO;
+
+	if (totalDiagnosticos == capacidadeDiagnosticos) {
+
+		if (!(novo = (tDiagnostico*) crescerVetor(diagnosticos, &capacidadeDiagnosticos,
+				totalDiagnosticos + 1, DIAGNOSTICOS_INICIAIS, sizeof(tDiagnostico))))
+			return ERRO;
+		diagnosticos = novo;
+	}
+
+	diagnosticos[totalDiagnosticos].mensagem = mensagem;
+	diagnosticos[totalDiagnosticos].linha = linha;
+	diagnosticos[totalDiagnosticos].coluna = coluna;
+	++totalDiagnosticos;
+
+	return SUCESSO;
+}
+
+/**
+ * Escreve uma cadeia JSON.
+ *
+ * Escreve a cadeia entre aspas, escapando aspas, barras invertidas e caracteres
+ *  de controle.
+ *
+ * @param saida FILE* : arquivo de saida.
+ * @param cadeia const char* : cadeia a ser escrita.
+ */
+static void escreverCadeiaJson(FILE *saida, const char *cadeia) {
+
+	fputc('"', saida);
+
+	for (; *cadeia; ++cadeia)
+		if (*cadeia == '"' || *cadeia == '\\')
+			fprintf(saida, "\\%c", *cadeia);
+		else if ((unsigned char) *cadeia < ' ')
+			fprintf(saida, "\\u%04x", (unsigned int) (unsigned char) *cadeia);
+		else
+			fputc(*cadeia, saida);
+
+	fputc('"', saida);
+}
+
+/**
+ * Escreve os diagnosticos.
+ *
+ * No formato texto escreve uma linha "arquivo:linha:coluna: mensagem" por erro,
+ *  seguida da situacao da compilacao. No formato JSON escreve um unico objeto com
+ *  o arquivo, a situacao, o numero de erros e a lista de diagnosticos.
+ *
+ * @param saida FILE* : arquivo de saida.
+ * @param situacao const char* : situacao da compilacao, para o formato JSON.
+ * @param resumo const char* : mensagem de conclusao, para o formato texto.
+ */
+void escreverDiagnosticos(FILE *saida, const char *situacao, const char *resumo) {
+
+	register unsigned int i;
+
+	if (formatoDiagnosticos == FORMATO_SILENCIOSO)
+		return;
+
+	if (formatoDiagnosticos == FORMATO_JSON) {
+
+		fprintf(saida, "{\"arquivo\": ");
+		escreverCadeiaJson(saida, arqDiagnosticos);
+		fprintf(saida, ", \"situacao\": \"%s\", \"erros\": %u, \"diagnosticos\": [",
+				situacao, totalDiagnosticos);
+
+		for (i = 0; i < totalDiagnosticos; ++i) {
+			fprintf(saida, "%s\n  {\"linha\": %u, \"coluna\": %u, \"mensagem\": ",
+					i ? "," : "", diagnosticos[i].linha, diagnosticos[i].coluna);
+			escreverCadeiaJson(saida, diagnosticos[i].mensagem);
+			fputc('}', saida);
+		}
+
+		fprintf(saida, "%s]}\n", totalDiagnosticos ? "\n" : "");
+	}
+	else {
+		for (i = 0; i < totalDiagnosticos; ++i)
+			fprintf(saida, "%s:%u:%u: %s\n", arqDiagnosticos, diagnosticos[i].linha,
+					diagnosticos[i].coluna, diagnosticos[i].mensagem);
+
+		fprintf(saida, "%s", resumo);
+	}
+
+	fflush(saida);
+}
+
+/**
+ * Diagnosticos guardados
+ *
+ * O vetor vale ate o fecharDiagnosticos.
+ *
+ * @param total unsigned int* : recebe o numero de diagnosticos.
+ * @return const tDiagnostico* : vetor de diagnosticos, na ordem em que foram relatados.
+ */
+const tDiagnostico *obterDiagnosticos(unsigned int *total) {
+
+	*total = totalDiagnosticos;
+	return diagnosticos;
+}
+
+/**
+ * Encerra os diagnosticos.
+ *
+ * Desaloca o vetor de diagnosticos.
+ */
+void fecharDiagnosticos(void) {
+
+	free(diagnosticos);
+
+	diagnosticos = NULL;
+	totalDiagnosticos = capacidadeDiagnosticos = 0;
+}
+
+#endif /* _DIAGNOSTICOS_H_ */
@@ -29,86 +29,267 @@
  * @version 2009.11.28
  */
 
+/*fork, waitpid e _exit da compilacao paralela, open_memstream do gerador em
+ * memoria (POSIX)*/
+#define _POSIX_C_SOURCE 200809L
+
 /*includes*/
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "padroes.h"
+#include "diagnosticos.h"
 #include "lexico.h"
 #include "sintatico.h"
 #include "semantico.h"
 #include "geradorCodigo.h"
+#include "incremental.h"
+#include "paralelo.h"
+#include "sintaticoTabela.h"
 
 /*programa principal*/
 /**
  * Funcao principal, ponto de partida.
  *
  * Ponto inicial da compilacao do Equidnas. Esta funcao recebera dois paramentros sendo
- *  que um deles eh optativo; por linha de comando.
+ *  que um deles eh optativo; por linha de comando. Antes dos nomes dos arquivos
+ *  podem vir as opcoes --max-errors N e --json, que controlam os diagnosticos.
+ * O nome "-" indica a entrada ou a saida padrao, assim o compilador pode ser
+ *  usado em pipes (equidnas - -); com a saida padrao os diagnosticos vao para a
+ *  saida de erros e o estado de saida indica se houve erros.
  * Inicialmente verificara se os parametros passados estao certo. Depois inicializara os
  *  analisadores, o ultimo a ser inicialisado eh o semantico.
  * Ao terminar a analise sintatica todos os outros analisadores sao terminados
- *  e o programa devolve o controle ao sistema operacional.
+ *  e o programa devolve o controle ao sistema operacional.
  */
 int main(int argc, char *argv[]) {
 
-      auto char arqDestino[51];
+      auto char *arqDestino;
+      auto char *arqOrigem = NULL, *nomeDestino = NULL, *nomePerfil = NULL, *nomeRastro = NULL;
+      auto unsigned int limiteErros = 0;
+      auto unsigned long maxMemoria = 0;
+      auto signed char formato = FORMATO_TEXTO, usoErrado = 0, porTabela = 0, incremental = 0, mapa = 0;
+      auto signed char instrumentar = 0;
+      auto tControle controle;
+      register int i;
+
+      /*separando as opcoes dos nomes de arquivos*/
+      for(i = 1; i < argc && !usoErrado; ++i)
+             if(!strcmp(argv[i], "--max-errors"))
+                    if(i + 1 < argc)
+                           limiteErros = (unsigned int) strtoul(argv[++i], NULL, 10);
+                    else
+                           usoErrado = 1;
+             else if(!strcmp(argv[i], "--max-memory"))
+                    if(i + 1 < argc)
+                           maxMemoria = strtoul(argv[++i], NULL, 10);
+                    else
+                           usoErrado = 1;
+             else if(!strcmp(argv[i], "--json"))
+                    formato = FORMATO_JSON;
+             else if(!strcmp(argv[i], "--tabela"))
+                    porTabela = 1;
+             else if(!strcmp(argv[i], "--incremental"))
+                    incremental = 1;
+#ifdef EQUIDNAS_PARALELO
+             /*so com make PARALELO=1, fora da ajuda enquanto nao houver medidas do ganho*/
+             else if(!strcmp(argv[i], "--jobs"))
+                    if(i + 1 < argc)
+                           iniciarParalelo((unsigned int) strtoul(argv[++i], NULL, 10));
+                    else
+                           usoErrado = 1;
+#endif
+             else if(!strcmp(argv[i], "--no-cse"))
+                    iniciarOtimizador(0);
+             else if(!strcmp(argv[i], "--source-map"))
+                    mapa = 1;
+             else if(!strcmp(argv[i], "--instrument"))
+                    instrumentar = 1;
+             else if(!strcmp(argv[i], "--profile-use"))
+                    if(i + 1 < argc)
+                           nomePerfil = argv[++i];
+                    else
+                           usoErrado = 1;
+             else if(!strcmp(argv[i], "--trace"))
+                    if(i + 1 < argc)
+                           nomeRastro = argv[++i];
+                    else
+                           usoErrado = 1;
+             else if(!strcmp(argv[i], "--inline"))
+                    if(i + 1 < argc)
+                           iniciarExpansao((unsigned int) strtoul(argv[++i], NULL, 10));
+                    else
+                           usoErrado = 1;
+             else if(!arqOrigem)
+                    arqOrigem = argv[i];
+             else if(!nomeDestino)
+                    nomeDestino = argv[i];
+             else
+                    usoErrado = 1;
 
       /*numero errado de argumentos
-       * se argc = 2 entao arqDestino = arqOrigem + ".c"
-       * se argc = 3 entao arqDestino = argv[2]
+       * sem arqDestino entao arqDestino = arqOrigem + ".c"
        */
-      if(argc != 2 && argc != 3) {
+      if(!arqOrigem || usoErrado) {
 
              printf("\n\nCompilador Equidnas: ALG para C\n\n");
-             printf("Use: %s arqOrigem arqDestino\n", argv[0]);
+             printf("Use: %s [opcoes] arqOrigem arqDestino\n", argv[0]);
              printf("arqOrigem: codigo fonte, parametro obrigatorio\n");
-             printf("arqDestino: arquivo de saida, parametro optativo\n\n");
+             printf("arqDestino: arquivo de saida, parametro optativo\n");
+             printf("- no lugar de um arquivo usa a entrada ou a saida padrao\n\n");
+             printf("Opcoes:\n");
+             printf("  --max-errors N: interrompe a analise apos N erros\n");
+             printf("  --max-memory N: interrompe a analise se o pico de memoria passar de\n");
+             printf("                  N megabytes e relata o pico na saida de erros\n");
+             printf("  --json: relata os erros em JSON na saida padrao\n");
+             printf("  --tabela: apenas verifica a sintaxe, com o analisador dirigido por tabela\n");
+             printf("  --incremental: recompila apenas os procedimentos alterados desde a\n");
+             printf("                 compilacao anterior, usando o cache arqDestino.cache\n");
+             printf("  --inline N: expande as chamadas de procedimentos com ate N tokens,\n");
+             printf("              zero desliga a expansao (padrao %d)\n", LIMITE_EXPANSAO_PADRAO);
+             printf("  --no-cse: nao elimina subexpressoes comuns nem propaga copias\n");
+             printf("  --source-map: marca o codigo gerado com diretivas #line e grava o\n");
+             printf("                mapa das posicoes no fonte em arqDestino.map.json\n");
+             printf("  --instrument: o programa gerado conta as entradas nos procedimentos e\n");
+             printf("                as condicoes dos se e enquanto, gravando arqDestino.perfil;\n");
+             printf("                desliga --incremental e a expansao em linha\n");
+             printf("  --profile-use arqPerfil: usa o perfil gravado para marcar condicoes,\n");
+             printf("                           procedimentos hot e cold e expandir em linha\n");
+             printf("  --trace arqRastro: grava os eventos da compilacao no formato de rastro\n");
+             printf("                     do Chrome, para chrome://tracing ou Perfetto\n\n");
              printf("Lais Augusta da Silva Meuchi\n");
              printf("Carlos Roberto Silveira Junior\n\t\t\t\t2009\n\n");
 
              return 1;
       }
 
+      /*sem o nome do destino, um fonte lido da entrada padrao vai para a saida padrao*/
+      if(!nomeDestino && !strcmp(arqOrigem, "-"))
+             nomeDestino = "-";
+
+      /*o cache e o perfil sao relidos ou nomeados a partir do arquivo destino*/
+      if(!strcmp(nomeDestino ? nomeDestino : "", "-") && (incremental || instrumentar)) {
+
+             printf("--incremental e --instrument precisam de um arquivo destino\n");
+             return 1;
+      }
+
+      /*o programa instrumentado mede os procedimentos como foram escritos*/
+      if(instrumentar) {
+
+             iniciarInstrumentacao();
+             iniciarParalelo(1);
+             iniciarExpansao(0);
+             incremental = 0;
+      }
+
+      /*lendo o perfil de execucao*/
+      if(nomePerfil && carregarPerfil(nomePerfil) != SUCESSO) {
+
+             printf("Erro ao ler o perfil de execucao\n");
+             return 2;
+      }
+
+      /*contadores do processador, apenas com EQUIDNAS_CONTADORES*/
+      iniciarContadores();
+
+      /*limite de memoria, conferido pelos analisadores lexico e sintatico*/
+      iniciarLimiteMemoria(maxMemoria);
+
+      /*ligando o rastro dos eventos*/
+      if(nomeRastro && iniciarRastro(nomeRastro) != SUCESSO) {
+
+             printf("Erro ao criar o arquivo do rastro\n");
+             return 2;
+      }
+
       /*inicializando analisador lexico com arquivo origem*/
-      if(iniciarAnalisadorLexico(argv[1]) == ERRO_AO_ABRIR_ORIGEM) {
+      rastroInicio("lexico", "fase");
+      controle = iniciarAnalisadorLexico(arqOrigem);
+      rastroFim(NULL);
+
+      if(controle == ERRO_AO_ABRIR_ORIGEM) {
 
+             fecharRastro();
              printf("Erro ao abrir o arquivo com o codigo fonte\n");
              return 2;
       }
 
       /*tratando nome do arquivo de saida*/
-      if(argc == 2) {
+      if(!nomeDestino) {
 
              /*se o nome nao foi especificado entao usa-se o nome do arquivo de
               * entrada porem com a extencao .c*/
-             register unsigned short int i = 0;
+             register char *extensao, *base;
 
-             /*copiando arquivo de entrada ate a extencao, final do nome ou
-              * limite*/
-             while(argv[1][i] != '\0' && argv[1][i] != '.' && i < 48)
-                    arqDestino[i] = argv[1][i++];
+             if(!(arqDestino = (char*) malloc(strlen(arqOrigem) + sizeof(".c")))) {
+
+                    printf("Memoria insuficiente\n");
+                    return 2;
+             }
+             strcpy(arqDestino, arqOrigem);
+
+             /*retirando a extencao do ultimo componente do caminho, se houver*/
+             base = strrchr(arqDestino, '/') ? strrchr(arqDestino, '/') + 1 : arqDestino;
+             if((extensao = strrchr(base, '.')) && extensao != base)
+                    *extensao = '\0';
 
-             arqDestino[i] = '\0';
              /*concatenando nova extencao*/
              strcat(arqDestino,".c");
       }
       else
              /*nome do arquivo especificado*/
-             strcpy(arqDestino, argv[2]);
+             arqDestino = nomeDestino;
+
+      /*saida padrao*/
+      if(!strcmp(arqDestino, "-"))
+             arqDestino = NULL;
+
+      /*iniciando os diagnosticos*/
+      iniciarDiagnosticos(arqOrigem, limiteErros, formato);
+      if(!arqDestino)
+             desviarDiagnosticos(stderr);
+
+      /*apenas a analise sintatica dirigida por tabela, sem gerar codigo*/
+      if(porTabela) {
+
+             rastroInicio("sintatico", "fase");
+             analiseSintaticaTabela();
+             rastroFim(NULL);
+
+             fecharAnalisadorLexico();
+             fecharDiagnosticos();
+             fecharRastro();
+
+             return 0;
+      }
 
       /*iniciando a analise semantica*/
       analisadorSemantico();
 
       /*iniciando o gerador de codigo*/
-      gerador(arqDestino);
+      if(arqDestino)
+             gerador(arqDestino);
+      else
+             geradorSaidaPadrao();
+
+      /*citando as posicoes do fonte no codigo gerado*/
+      if(mapa)
+             iniciarMapa(arqOrigem);
+
+      /*reaproveitando os procedimentos da compilacao anterior*/
+      if(incremental)
+             iniciarIncremental(arqDestino);
 
       /*******************************************
        *analise sintatica  desencadeia as  outras*
        *******************************************/
+      rastroInicio("sintatico", "fase");
       analiseSintatica();/************************
        *******************************************
-       *terminada a analise sintatica e as outras*
+       *terminada a analise sintatica e as outras*
        *******************************************/
+      rastroFim(NULL);
 
       /*terminando o analisador lexico*/
       fecharAnalisadorLexico();
@@ -116,8 +297,37 @@ int main(int argc, char *argv[]) {
       /*terminando o analisador semantico*/
       fecharSemantico();
 
+      /*terminando a expansao de procedimentos*/
+      fecharExpansao();
+
       /*terminando o gerador de codigo*/
+      rastroInicio("gerador", "fase");
       fecharGerador();
+      rastroFim(NULL);
+
+      /*gravando o cache da compilacao incremental*/
+      fecharIncremental();
+
+      /*terminando os diagnosticos*/
+      fecharDiagnosticos();
+
+      /*terminando a instrumentacao e o perfil*/
+      fecharPerfil();
+
+      /*gravando o rastro, depois de todos os eventos*/
+      fecharRastro();
+
+      /*totais dos contadores do processador*/
+      fecharContadores();
+
+      /*pico de memoria da compilacao inteira*/
+      if(maxMemoria)
+             fprintf(stderr, "Pico de memoria: %lu MB, limite %lu MB\n",
+                     picoMemoriaMegabytes(), maxMemoria);
+
+      /*o codigo ja entregue na saida padrao nao pode ser apagado*/
+      if(!arqDestino)
+             return contErros ? 1 : 0;
 
       /*sucesso*/
       return 0;
@@ -0,0 +1,92 @@
+/**
+ * equidnas.h
+ *
+ * Interface da biblioteca do compilador Equidnas.
+ *
+ * Compila um programa ALG que esta em memoria e devolve o codigo C e os
+ *  diagnosticos tambem em memoria, sem abrir arquivos. Eh o unico cabecalho
+ *  necessario para quem usa a biblioteca (libequidnas.a); os demais modulos
+ *  ficam escondidos nela.
+ * O compilador guarda seu estado em variaveis globais, entao as chamadas nao
+ *  podem ser feitas ao mesmo tempo por mais de uma thread.
+ *
+ * @see biblioteca.c
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _EQUIDNAS_H_
+#define _EQUIDNAS_H_
+
+/*includes*/
+#include <stddef.h>
+
+/*situacoes da compilacao*/
+#define EQUIDNAS_SUCESSO 0 /*codigo gerado*/
+#define EQUIDNAS_ERROS 1 /*programa com erros, ver os diagnosticos*/
+#define EQUIDNAS_FIM_INESPERADO 2 /*o programa termina antes do ponto final*/
+#define EQUIDNAS_VAZIO 3 /*nenhum token no programa*/
+#define EQUIDNAS_SEM_MEMORIA 4 /*a compilacao nao pode ser feita*/
+
+/*novos tipos*/
+/**
+ * @brief Opcoes da compilacao.
+ */
+typedef struct {
+	unsigned int maxErros; /**interrompe a analise apos tantos erros, zero para nao haver limite*/
+	unsigned int limiteExpansao; /**tamanho maximo, em tokens, de um procedimento expandido; zero desliga*/
+	signed char semOtimizacao; /**diferente de zero para nao eliminar subexpressoes comuns*/
+} tOpcoesEquidnas;
+
+/**
+ * @brief Um erro encontrado no programa.
+ */
+typedef struct {
+	const char *mensagem; /**texto do erro, constante da biblioteca*/
+	unsigned int linha; /**linha onde o erro foi detectado*/
+	unsigned int coluna; /**coluna onde o erro foi detectado*/
+} tDiagnosticoEquidnas;
+
+/**
+ * @brief Resultado da compilacao.
+ */
+typedef struct {
+	int situacao; /**EQUIDNAS_SUCESSO, EQUIDNAS_ERROS, ...*/
+	char *codigo; /**codigo C terminado em '\0', NULL se nao houve sucesso*/
+	size_t tamanhoCodigo; /**bytes do codigo C, sem o '\0'*/
+	tDiagnosticoEquidnas *diagnosticos; /**erros na ordem em que foram encontrados*/
+	unsigned int totalDiagnosticos; /**numero de erros*/
+} tResultadoEquidnas;
+
+/*funcoes e procedimentos*/
+/**
+ * Preenche as opcoes com os valores da linha de comando sem opcoes.
+ *
+ * @param opcoes tOpcoesEquidnas* : opcoes a preencher.
+ */
+void equidnasOpcoesPadrao(tOpcoesEquidnas *opcoes);
+
+/**
+ * Compila um programa ALG
+ *
+ * @param fonte const char* : codigo-fonte, nao precisa terminar em '\0'.
+ * @param tamanho size_t : numero de bytes do codigo-fonte.
+ * @param opcoes const tOpcoesEquidnas* : opcoes, NULL para as padrao.
+ * @param resultado tResultadoEquidnas* : recebe o resultado, que deve ser
+ *         liberado com equidnasLiberar.
+ * @return int : a situacao da compilacao, tambem guardada no resultado.
+ */
+int equidnasCompilar(const char *fonte, size_t tamanho, const tOpcoesEquidnas *opcoes,
+		tResultadoEquidnas *resultado);
+
+/**
+ * Libera o codigo e os diagnosticos de um resultado.
+ *
+ * @param resultado tResultadoEquidnas* : resultado de equidnasCompilar.
+ */
+void equidnasLiberar(tResultadoEquidnas *resultado);
+
+#endif /* _EQUIDNAS_H_ */
@@ -0,0 +1,161 @@
+/**
+ * espalhamento.h
+ *
+ * Funcoes de espalhamento e indice de espalhamento com enderecamento aberto.
+ *
+ * O FNV-1a de 64 bits espalha nomes e formas nas tabelas e da as impressoes
+ *  digitais dos trechos do fonte e do perfil. O espalhamento polinomial ordena
+ *  as chaves da arvore do escopo global e da pilha do escopo local.
+ * O indice guarda, em cada posicao, o numero de um item mais um; os itens ficam
+ *  em um vetor de quem usa o indice, na ordem de insercao. As colisoes sao
+ *  resolvidas por sondagem linear e o indice tem sempre pelo menos o dobro de
+ *  posicoes que itens, assim as sondagens sao curtas.
+ *
+ * @see nomes
+ * @see assinaturas
+ * @see expansao
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _ESPALHAMENTO_H_
+#define _ESPALHAMENTO_H_
+
+/*includes*/
+#include <stdlib.h>
+#include "padroes.h"
+
+/*defines*/
+#define ESPALHAMENTO_BASE ((tChave) 0xcbf29ce4UL << 32 | 0x84222325UL) /*valor inicial do FNV-1a*/
+#define ESPALHAMENTO_PRIMO (((tChave) 1 << 40) + 0x1b3) /*primo do FNV-1a de 64 bits*/
+
+/**
+ * Acrescenta um byte a um espalhamento FNV-1a.
+ */
+#define ESPALHAR(valor, byte) (((valor) ^ (unsigned char) (byte)) * ESPALHAMENTO_PRIMO)
+
+/**
+ * Posicao inicial de um espalhamento no indice e posicao seguinte na sondagem.
+ */
+#define POSICAO_INDICE(indice, valor) ((unsigned int) (valor) & ((indice)->capacidade - 1))
+#define PROXIMA_POSICAO(indice, i) (((i) + 1) & ((indice)->capacidade - 1))
+
+/*novos tipos*/
+/**
+ * @brief Indice de espalhamento sobre um vetor de itens.
+ */
+typedef struct {
+	unsigned int *item; /**numero do item mais um em cada posicao, zero se vazia*/
+	unsigned int capacidade; /**numero de posicoes, potencia de dois*/
+} tIndice;
+
+/*funcoes e procedimentos*/
+/**
+ * Espalhamento FNV-1a de um trecho de bytes.
+ *
+ * @param bytes const char* : trecho, nao precisa terminar em '\0'.
+ * @param total unsigned int : numero de bytes.
+ * @return tChave : valor de espalhamento.
+ */
+tChave espalharBytes(const char *bytes, unsigned int total) {
+
+	auto tChave valor = ESPALHAMENTO_BASE;
+
+	while (total--)
+		valor = ESPALHAR(valor, *bytes++);
+
+	return valor;
+}
+
+/**
+ * Espalhamento FNV-1a de uma cadeia.
+ *
+ * @param cadeia const char* : cadeia terminada em '\0'.
+ * @return tChave : valor de espalhamento.
+ */
+tChave espalharCadeia(const char *cadeia) {
+
+	auto tChave valor = ESPALHAMENTO_BASE;
+
+	while (*cadeia)
+		valor = ESPALHAR(valor, *cadeia++);
+
+	return valor;
+}
+
+/**
+ * Espalhamento polinomial de uma cadeia
+ *
+ * Espalha nomes parecidos como v12 e v21. Hashes iguais ainda sao possiveis e
+ *  sao desempatados pelo nome por quem compara as chaves.
+ *
+ * @param cadeia const char* : cadeia terminada em '\0'.
+ * @return tChave : valor de espalhamento.
+ */
+tChave espalharPolinomial(const char *cadeia) {
+
+	auto tChave valor = 0;
+
+	while (*cadeia)
+		valor = valor * 131 + (unsigned char) *cadeia++;
+
+	return valor;
+}
+
+/**
+ * Dobra o indice e reposiciona os itens.
+ *
+ * Deve ser chamado antes de uma insercao que deixaria o indice com menos do
+ *  dobro de posicoes que itens. Se faltar memoria o indice continua o mesmo.
+ *
+ * @param indice tIndice* : indice, vazio na primeira chamada.
+ * @param inicial unsigned int : numero de posicoes da primeira alocacao,
+ *         potencia de dois.
+ * @param total unsigned int : numero de itens ja guardados.
+ * @param espalharItem tChave (*)(unsigned int) : espalhamento do item de um
+ *         numero, o mesmo usado para procura-lo.
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+tControle crescerIndice(tIndice *indice, unsigned int inicial, unsigned int total,
+		tChave (*espalharItem)(unsigned int)) {
+
+	auto unsigned int *item;
+	auto tIndice novo;
+	register unsigned int i, posicao;
+
+	novo.capacidade = indice->capacidade ? 2 * indice->capacidade : inicial;
+
+	if (!(item = (unsigned int*) calloc(novo.capacidade, sizeof(unsigned int))))
+		return ERRO;
+	novo.item = item;
+
+	for (i = 0; i < total; ++i) {
+
+		for (posicao = POSICAO_INDICE(&novo, espalharItem(i)); item[posicao];)
+			posicao = PROXIMA_POSICAO(&novo, posicao);
+
+		item[posicao] = i + 1;
+	}
+
+	free(indice->item);
+	*indice = novo;
+
+	return SUCESSO;
+}
+
+/**
+ * Destroi um indice.
+ *
+ * @param indice tIndice* : indice, que volta a ficar vazio.
+ */
+void destruirIndice(tIndice *indice) {
+
+	free(indice->item);
+	indice->item = NULL;
+	indice->capacidade = 0;
+}
+
+#endif /* _ESPALHAMENTO_H_ */
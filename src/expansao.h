@@ -0,0 +1,538 @@
+/**
+ * expansao.h
+ *
+ * Expansao em linha de procedimentos pequenos.
+ *
+ * Cada procedimento compilado eh registrado com os limites dos seus tokens. Um
+ *  procedimento eh expansivel se nao chama a si mesmo e se seu tamanho, em
+ *  tokens, somado ao dos procedimentos expansiveis que ele chama, nao passa do
+ *  limite, ajustado pelo perfil de execucao quando ha um (perfil). A chamada de
+ *  um procedimento expansivel nao gera uma chamada em C: o analisador volta aos
+ *  tokens do procedimento e traduz seu corpo de novo, no lugar da chamada,
+ *  dentro de um bloco em que os parametros sao variaveis iniciadas com os
+ *  argumentos. Os nomes locais do procedimento expandido recebem um sufixo
+ *  proprio da expansao (geradorCodigo), assim nao colidem com os de quem chama.
+ * Como um procedimento so pode chamar os declarados antes dele, as expansoes
+ *  dentro de expansoes sempre terminam. A expansao so eh feita se nenhum nome
+ *  global usado pelo procedimento estiver escondido por um nome local da funcao
+ *  C onde o bloco sera escrito.
+ *
+ * @see sintatico
+ * @see geradorCodigo
+ * @see incremental
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _EXPANSAO_H_
+#define _EXPANSAO_H_
+
+/*includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "espalhamento.h"
+#include "semantico.h"
+#include "geradorCodigo.h"
+#include "perfil.h"
+
+/*defines*/
+#define LIMITE_EXPANSAO_PADRAO 32 /*tamanho maximo, em tokens, de um procedimento expandido*/
+#define EXPANSIVEIS_INICIAIS 64 /*capacidade inicial do indice de procedimentos, potencia de dois*/
+#define ARGUMENTOS_INICIAIS 8 /*capacidade inicial do vetor de argumentos*/
+
+/*trazendo funcao de outro modulo*/
+extern unsigned int getIndiceToken(void);
+extern void irParaToken(unsigned int);
+extern tCodigoToken signoToken(unsigned int);
+extern const char *lexemaToken(unsigned int);
+extern tChave impressaoTokens(unsigned int, unsigned int);
+extern tControle getToken(tToken*);
+extern tControle sintCorpoExpandido(tToken*);
+
+/*novos tipos*/
+/**
+ * @brief Procedimento registrado para expansao.
+ *
+ * Os limites sao posicoes no fluxo de tokens.
+ */
+typedef struct {
+	const char *nome; /**nome do procedimento, no bloco de lexemas*/
+	unsigned int inicio; /**token procedimento*/
+	unsigned int corpo; /**primeiro token depois do cabecalho*/
+	unsigned int instrucoes; /**token inicio do bloco de comandos*/
+	unsigned int fim; /**token seguinte ao ponto-e-virgula final*/
+	signed char expansivel; /**diferente de zero se as chamadas podem ser expandidas*/
+	unsigned int tamanho; /**tokens do procedimento e das expansoes que ele faz*/
+	tChave impressao; /**impressao digital dos tokens, zero se nao for expansivel*/
+} tExpansivel;
+
+/**
+ * @brief Argumento de uma chamada, como foi escrito no ponto da chamada.
+ */
+typedef struct {
+	const char *nome; /**nome do argumento*/
+	unsigned int sufixo; /**sufixo do nome no ponto da chamada, zero se nenhum*/
+} tArgumentoExpansao;
+
+/*variaveis globais*/
+static unsigned int limiteExpansao = LIMITE_EXPANSAO_PADRAO; /**zero desliga a expansao*/
+static tExpansivel *expansiveis; /**procedimentos registrados, na ordem do fonte*/
+static unsigned int totalExpansiveis; /**numero de procedimentos registrados*/
+static unsigned int capacidadeExpansiveis; /**procedimentos alocados*/
+static tIndice indiceExpansiveis; /**indice dos nomes, com o dobro de posicoes que procedimentos*/
+static tArgumentoExpansao *argumentos; /**argumentos da ultima chamada*/
+static unsigned int totalArgumentos; /**numero de argumentos da ultima chamada*/
+static unsigned int capacidadeArgumentos; /**argumentos alocados*/
+static char *chamadaExpandida; /**procedimento da chamada em analise que sera expandida, NULL se nenhuma*/
+static unsigned int profundidadeExpansao; /**expansoes em andamento, uma dentro da outra, numeram os sufixos*/
+static tPilhaHash escopoFuncao; /**escopo local da funcao C onde a expansao externa eh escrita*/
+
+/*funcoes e procedimentos*/
+/**
+ * Define o limite da expansao em linha.
+ *
+ * @param limite unsigned int : tamanho maximo, em tokens; zero desliga a expansao.
+ */
+void iniciarExpansao(unsigned int limite) {
+
+	limiteExpansao = limite;
+}
+
+/**
+ * Espalhamento do nome de um procedimento registrado. Funcao para uso interno.
+ *
+ * @param numero unsigned int : ordem do procedimento no registro.
+ * @return tChave : valor de espalhamento.
+ */
+static tChave _espalharExpansivel(unsigned int numero) {
+
+	return espalharCadeia(expansiveis[numero].nome);
+}
+
+/**
+ * Procura a posicao de um nome na tabela. Funcao para uso interno.
+ *
+ * @param nome const char* : nome do procedimento.
+ * @return posicao do nome ou da primeira posicao vazia encontrada.
+ */
+static unsigned int _posicaoExpansivel(const char *nome) {
+
+	register unsigned int i = POSICAO_INDICE(&indiceExpansiveis, espalharCadeia(nome));
+
+	while (indiceExpansiveis.item[i] && strcmp(expansiveis[indiceExpansiveis.item[i] - 1].nome, nome))
+		i = PROXIMA_POSICAO(&indiceExpansiveis, i);
+
+	return i;
+}
+
+/**
+ * Busca um procedimento registrado. Funcao para uso interno.
+ *
+ * @param nome const char* : nome do procedimento.
+ * @return o procedimento ou NULL se nao foi registrado.
+ */
+static tExpansivel *_buscarExpansivel(const char *nome) {
+
+	register unsigned int posicao;
+
+	if (!totalExpansiveis)
+		return NULL;
+
+	posicao = _posicaoExpansivel(nome);
+	return indiceExpansiveis.item[posicao] ? &expansiveis[indiceExpansiveis.item[posicao] - 1] : NULL;
+}
+
+/**
+ * Garante espaco para mais um procedimento no indice e no vetor. Funcao para
+ *  uso interno.
+ *
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+static tControle _crescerExpansiveis(void) {
+
+	auto tExpansivel *vetor;
+
+	if (2 * (totalExpansiveis + 1) > indiceExpansiveis.capacidade
+			&& crescerIndice(&indiceExpansiveis, EXPANSIVEIS_INICIAIS, totalExpansiveis,
+					_espalharExpansivel) != SUCESSO)
+		return ERRO;
+
+	if (!(vetor = (tExpansivel*) crescerVetor(expansiveis, &capacidadeExpansiveis,
+			totalExpansiveis + 1, EXPANSIVEIS_INICIAIS / 2, sizeof(tExpansivel))))
+		return ERRO;
+	expansiveis = vetor;
+
+	return SUCESSO;
+}
+
+/**
+ * Verifica se um nome eh declarado no cabecalho ou nas variaveis de um
+ *  procedimento. Funcao para uso interno.
+ *
+ * @param proc tExpansivel* : procedimento.
+ * @param nome const char* : nome procurado.
+ * @return diferente de zero se o nome eh local ao procedimento.
+ */
+static signed char _declaradoEm(tExpansivel *proc, const char *nome) {
+
+	register unsigned int i;
+
+	for (i = proc->inicio + 2; i < proc->instrucoes; ++i)
+		if (signoToken(i) == IDENTIFICADOR && !strcmp(lexemaToken(i), nome))
+			return 1;
+
+	return 0;
+}
+
+/**
+ * Encontra o fim de um procedimento sem analisa-lo.
+ *
+ * Percorre os codigos dos tokens contando os blocos abertos: inicio e se abrem,
+ *  fim e senao fecham. O procedimento termina no ponto-e-virgula que segue o fim
+ *  do seu bloco principal.
+ *
+ * @param inicio unsigned int : posicao do token procedimento.
+ * @return posicao do token seguinte ao procedimento ou zero se nao encontrou.
+ */
+unsigned int expFimProcedimento(unsigned int inicio) {
+
+	register unsigned int i, profundidade = 0;
+	register tCodigoToken signo;
+
+	for (i = inicio + 1; (signo = signoToken(i)); ++i)
+		if (signo == INICIO || signo == SE)
+			++profundidade;
+		else if (signo == FIM || signo == SENAO) {
+			if (!profundidade)
+				return 0;
+			if (!--profundidade && signo == FIM)
+				return signoToken(i + 1) == PONTO_E_VIRGULA ? i + 2 : 0;
+		}
+		else if (signo == PROCEDIMENTO)
+			return 0;
+
+	return 0;
+}
+
+/**
+ * Analisa os tokens de um procedimento: limites do cabecalho e do bloco de
+ *  comandos, tamanho e se ele eh expansivel. Funcao para uso interno.
+ *
+ * @param proc tExpansivel* : recebe a analise, menos a impressao digital.
+ * @param inicio unsigned int : posicao do token procedimento.
+ * @param fim unsigned int : posicao do token seguinte ao procedimento.
+ * @return SUCESSO ou ERRO se o cabecalho esta incompleto.
+ */
+static tControle _analisarExpansivel(tExpansivel *proc, unsigned int inicio, unsigned int fim) {
+
+	auto tExpansivel *chamado;
+	register unsigned int i = inicio + 2;
+
+	proc->nome = lexemaToken(inicio + 1);
+	proc->inicio = inicio;
+	proc->fim = fim;
+
+	/*cabecalho: nome, parametros opcionais e ponto-e-virgula*/
+	if (signoToken(i) == ABRE_PARENTESES)
+		while (i < fim && signoToken(i) != FECHA_PARENTESES)
+			++i;
+	if (i >= fim || signoToken(i + (signoToken(i) == FECHA_PARENTESES)) != PONTO_E_VIRGULA)
+		return ERRO;
+	proc->corpo = i + 1 + (signoToken(i) == FECHA_PARENTESES);
+
+	for (i = proc->corpo; i < fim && signoToken(i) != INICIO; ++i)
+		;
+	if (i >= fim)
+		return ERRO;
+	proc->instrucoes = i;
+
+	/*chamadas a si mesmo e tamanho das expansoes feitas no corpo*/
+	proc->expansivel = 1;
+	proc->tamanho = fim - inicio;
+	for (i = proc->instrucoes; i < fim; ++i)
+		if (signoToken(i) == IDENTIFICADOR) {
+			if (!strcmp(lexemaToken(i), proc->nome))
+				proc->expansivel = 0;
+			else if ((chamado = _buscarExpansivel(lexemaToken(i))) && chamado->expansivel)
+				proc->tamanho += chamado->tamanho;
+		}
+
+	/*o perfil de execucao aumenta o limite dos procedimentos hot e zera o dos cold*/
+	if (proc->tamanho > perfilLimiteExpansao(proc->nome, limiteExpansao))
+		proc->expansivel = 0;
+
+	return SUCESSO;
+}
+
+/**
+ * Registra um procedimento
+ *
+ * Chamado para cada procedimento compilado, reaproveitado da compilacao
+ *  anterior ou compilado por outro processo, na ordem do fonte. Procedimentos
+ *  com o cabecalho incompleto ou ja registrados sao ignorados.
+ *
+ * @param inicio unsigned int : posicao do token procedimento.
+ * @param fim unsigned int : posicao do token seguinte ao procedimento.
+ */
+void expRegistrar(unsigned int inicio, unsigned int fim) {
+
+	auto tExpansivel *proc;
+	auto const char *nome = lexemaToken(inicio + 1);
+
+	if (!nome || signoToken(inicio + 1) != IDENTIFICADOR || _buscarExpansivel(nome))
+		return;
+
+	if (_crescerExpansiveis() != SUCESSO)
+		return;
+
+	proc = &expansiveis[totalExpansiveis];
+	if (_analisarExpansivel(proc, inicio, fim) != SUCESSO)
+		return;
+
+	proc->impressao = 0;
+	if (proc->expansivel && !(proc->impressao = impressaoTokens(inicio, fim - inicio)))
+		proc->impressao = 1;
+
+	indiceExpansiveis.item[_posicaoExpansivel(nome)] = ++totalExpansiveis;
+}
+
+/**
+ * Antecipa se um procedimento sera expansivel
+ *
+ * Chamado no cabecalho, antes de o procedimento ser compilado e registrado,
+ *  com os mesmos procedimentos anteriores ja registrados. Todas as chamadas de
+ *  um procedimento expansivel podem ser expandidas, entao o gerador nao escreve
+ *  a sua definicao como static, que o compilador C avisaria sem uso.
+ *
+ * @param inicio unsigned int : posicao do token procedimento.
+ * @return signed char : diferente de zero se o procedimento sera expansivel.
+ */
+signed char expSeraExpansivel(unsigned int inicio) {
+
+	auto tExpansivel proc;
+	auto unsigned int fim;
+
+	if (!limiteExpansao || signoToken(inicio + 1) != IDENTIFICADOR
+			|| !(fim = expFimProcedimento(inicio)))
+		return 0;
+
+	return _analisarExpansivel(&proc, inicio, fim) == SUCESSO && proc.expansivel;
+}
+
+/**
+ * Impressao digital de um procedimento expansivel
+ *
+ * Usada pela compilacao incremental: quem chama um procedimento expansivel
+ *  carrega o seu corpo, e precisa ser compilado de novo se o corpo mudar ou se
+ *  ele deixar de ser expansivel, ou passar a ser.
+ *
+ * @param nome const char* : nome do procedimento.
+ * @return tChave : impressao dos tokens do procedimento, zero se ele nao eh
+ *          expansivel.
+ */
+tChave expImpressao(const char *nome) {
+
+	auto tExpansivel *proc = _buscarExpansivel(nome);
+
+	return proc ? proc->impressao : 0;
+}
+
+/**
+ * Decide se uma chamada sera expandida
+ *
+ * Chamado com o nome do procedimento, antes da lista de argumentos. Verifica
+ *  se a geracao esta ativa, se o procedimento eh expansivel e se os nomes
+ *  globais que ele usa nao estao escondidos na funcao C da chamada. Quem chama
+ *  suspende a geracao ate o fim da lista de argumentos.
+ *
+ * @param nome char* : nome do procedimento chamado.
+ * @return signed char : diferente de zero se a chamada deve ser expandida.
+ */
+signed char expExpansivel(char *nome) {
+
+	auto tExpansivel *proc = _buscarExpansivel(nome);
+	auto tPilhaHash atual = NULL;
+	auto signed char expandir = 1;
+	register unsigned int i;
+
+	totalArgumentos = 0;
+	chamadaExpandida = NULL;
+
+	if (!limiteExpansao || !GERANDO || !proc || !proc->expansivel)
+		return 0;
+
+	/*dentro de outra expansao, a funcao C eh a da expansao externa*/
+	if (profundidadeExpansao)
+		atual = semTrocarLocal(escopoFuncao);
+
+	for (i = proc->instrucoes; i < proc->fim && expandir; ++i)
+		if (signoToken(i) == IDENTIFICADOR && !_declaradoEm(proc, lexemaToken(i))
+				&& semEhLocal(lexemaToken(i)))
+			expandir = 0;
+
+	if (profundidadeExpansao)
+		semTrocarLocal(atual);
+
+	if (expandir)
+		chamadaExpandida = nome;
+
+	return expandir;
+}
+
+/**
+ * Registra um argumento da chamada
+ *
+ * Guarda o nome do argumento com o sufixo que ele tem no ponto da chamada,
+ *  usados para iniciar o parametro correspondente na expansao. So a chamada
+ *  que sera expandida guarda seus argumentos.
+ *
+ * @param nome char* : nome do argumento.
+ * @return SUCESSO ou ERRO se faltar memoria; nesse caso a chamada nao pode ser
+ *          expandida (expDesistir).
+ */
+tControle expArgumento(char *nome) {
+
+	auto tArgumentoExpansao *novos;
+
+	if (!chamadaExpandida)
+		return SUCESSO;
+
+	if (totalArgumentos == capacidadeArgumentos) {
+
+		if (!(novos = (tArgumentoExpansao*) crescerVetor(argumentos, &capacidadeArgumentos,
+				totalArgumentos + 1, ARGUMENTOS_INICIAIS, sizeof(tArgumentoExpansao))))
+			return ERRO;
+		argumentos = novos;
+	}
+
+	argumentos[totalArgumentos].nome = nome;
+	argumentos[totalArgumentos++].sufixo = gecSufixo(nome);
+
+	return SUCESSO;
+}
+
+/**
+ * Desiste de expandir a chamada em analise
+ *
+ * Usado quando um argumento nao pode ser guardado. Retoma a geracao, suspensa
+ *  desde o nome do procedimento, e escreve o inicio da chamada em C com os
+ *  argumentos ja vistos, cada um seguido da virgula; o resto da lista eh escrito
+ *  pelo analisador. A chamada passa a ser uma chamada comum e expExpandir nao
+ *  faz nada. Sem chamada a expandir, nao faz nada.
+ */
+void expDesistir(void) {
+
+	register unsigned int i;
+
+	if (!chamadaExpandida)
+		return;
+
+	gecSuspender(0);
+
+	gecGeraCodigo(chamadaExpandida);
+	gecGeraCodigo("( ");
+	for (i = 0; i < totalArgumentos; ++i) {
+		gecIdentificador((char*) argumentos[i].nome);
+		gecAddVirgula();
+	}
+
+	chamadaExpandida = NULL;
+}
+
+/**
+ * Expande uma chamada
+ *
+ * Chamado depois da chamada ser verificada, com os argumentos registrados por
+ *  expArgumento. Escreve um bloco com os parametros iniciados pelos argumentos
+ *  e traduz de novo o corpo do procedimento, com um escopo local proprio. Ao
+ *  final devolve o escopo e a posicao no fluxo de tokens de quem chamou. Se
+ *  houve desistencia (expDesistir) a chamada ja esta escrita em C.
+ *
+ * @param nome char* : nome do procedimento chamado.
+ * @return tControle : resultado da analise do corpo.
+ */
+tControle expExpandir(char *nome) {
+
+	auto tExpansivel *proc = _buscarExpansivel(nome);
+	auto unsigned int retorno = getIndiceToken(), primeiro, i, k = 0, sufixoAnterior;
+	auto tPilhaHash anterior;
+	auto tControle erro;
+	auto tToken token;
+
+	if (!chamadaExpandida)
+		return SUCESSO;
+	chamadaExpandida = NULL;
+
+	if (!proc)
+		return ERRO;
+
+	anterior = semTrocarLocal(NULL);
+	if (!profundidadeExpansao++)
+		escopoFuncao = anterior;
+
+	/*blocos irmaos podem repetir o sufixo, so os encaixados precisam diferir*/
+	gecGeraCodigo("\n{");
+	sufixoAnterior = gecExpansao(profundidadeExpansao);
+
+	/*parametros, em grupos terminados pelo tipo*/
+	primeiro = proc->inicio + 3;
+	for (i = primeiro; i + 1 < proc->corpo; ++i) {
+
+		irParaToken(i);
+		getToken(&token);
+
+		if (token.signo == IDENTIFICADOR)
+			semEmpilhaTemp(&token);
+		else if (token.signo == INTEIRO || token.signo == REAL) {
+
+			for (; primeiro < i; ++primeiro)
+				if (signoToken(primeiro) == IDENTIFICADOR && k < totalArgumentos) {
+					gecDecParametroExpandido(token.signo, lexemaToken(primeiro),
+							argumentos[k].nome, argumentos[k].sufixo);
+					++k;
+				}
+
+			semDeclareVariaveis(1, token.signo);
+		}
+	}
+
+	/*corpo do procedimento*/
+	irParaToken(proc->corpo);
+	getToken(&token);
+	erro = sintCorpoExpandido(&token);
+
+	semLimpaLocal();
+	semTrocarLocal(anterior);
+	--profundidadeExpansao;
+
+	gecExpansao(sufixoAnterior);
+	gecGeraCodigo("\n}\n");
+
+	irParaToken(retorno);
+
+	return erro;
+}
+
+/**
+ * Encerra a expansao em linha
+ *
+ * Desaloca o indice e o vetor de procedimentos e o vetor de argumentos.
+ */
+void fecharExpansao(void) {
+
+	free(expansiveis);
+	destruirIndice(&indiceExpansiveis);
+	free(argumentos);
+
+	expansiveis = NULL;
+	argumentos = NULL;
+	chamadaExpandida = NULL;
+	totalExpansiveis = capacidadeExpansiveis = totalArgumentos = capacidadeArgumentos = 0;
+}
+
+#endif /* _EXPANSAO_H_ */
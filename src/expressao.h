@@ -0,0 +1,154 @@
+/**
+ * Representacao intermediaria das expressoes.
+ *
+ * As expressoes sao montadas pelo analisador sintatico como arvores, em vez de
+ *  traduzidas token a token. O analisador semantico tipa cada no de baixo para
+ *  cima (semTiparExpressao) e o gerador percorre a arvore ja tipada, inserindo
+ *  as conversoes de inteiro para real (gecExpressao).
+ * Os parenteses do fonte sao mantidos como nos de agrupamento, assim a arvore
+ *  reproduz a mesma estrutura do fonte sem regras de precedencia no gerador.
+ *
+ * @see sintatico
+ * @see semantico
+ * @see geradorCodigo
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _EXPRESSAO_H_
+#define _EXPRESSAO_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "padroes.h"
+
+/*tipos de dados e estruturas*/
+
+/**
+ * @brief No de uma expressao.
+ *
+ * O operador eh o codigo do token que originou o no: IDENTIFICADOR,
+ *  NUMERO_INTEIRO e NUMERO_REAL nas folhas; MAIS, MENOS, ASTERISCO e BARRA
+ *  nas operacoes, que sao unarias quando nao ha operando direito; e
+ *  ABRE_PARENTESES no agrupamento, cujo conteudo fica a esquerda.
+ */
+struct sNoExpressao {
+
+	tCodigoToken operador; /**codigo do token do no*/
+	signed char tipo; /**INTEIRO ou REAL, preenchido pelo analisador semantico*/
+	char *cadeia; /**cadeia do token, aponta para o bloco de lexemas*/
+
+	struct sNoExpressao *esquerda; /**operando esquerdo, unico ou agrupado*/
+	struct sNoExpressao *direita; /**operando direito das operacoes binarias*/
+};
+
+typedef struct sNoExpressao tNoExpressao; /**tipo para o no da expressao*/
+typedef tNoExpressao* tExpressao; /**tipo para expressao, ponteiro para a raiz*/
+
+/**
+ * @brief Visita a um no do ramo esquerdo, recebe o no, o pai e o contexto.
+ */
+typedef void (*tVisitaExpressao)(tExpressao, tExpressao, void*);
+
+/*funcoes e procedimentos*/
+/**
+ * Cria um no de expressao.
+ *
+ * O tipo fica indefinido ate a tipagem. Sem memoria devolve NULL, que eh tratado
+ *  como uma expressao ausente pelas outras funcoes.
+ *
+ * @param token tToken* : token do no, operador ou operando.
+ * @param esquerda tExpressao : operando esquerdo, unico ou agrupado, ou NULL.
+ * @param direita tExpressao : operando direito ou NULL.
+ * @return tExpressao : o novo no.
+ */
+tExpressao criarExpressao(tToken *token, tExpressao esquerda, tExpressao direita) {
+
+	auto tExpressao no = (tExpressao) malloc(sizeof(tNoExpressao));
+
+	if (no) {
+		no->operador = token->signo;
+		no->tipo = INTEIRO;
+		no->cadeia = token->cadeia;
+		no->esquerda = esquerda;
+		no->direita = direita;
+	}
+
+	return no;
+}
+
+/**
+ * Percorre o ramo esquerdo de uma expressao.
+ *
+ * Os termos e os fatores sao associados a esquerda, entao o ramo esquerdo tem o
+ *  tamanho da expressao e eh percorrido em laco: na descida cada ponteiro
+ *  esquerdo passa a apontar para o pai e na subida volta a apontar para o filho.
+ *  Os ramos direitos ficam para as visitas, que podem percorre-los com outra
+ *  chamada; eles so sao fundos quando os parenteses sao.
+ *
+ * @param raiz tExpressao : raiz da expressao, pode ser nula.
+ * @param antes tVisitaExpressao : chamada na descida, antes do operando
+ *         esquerdo, ou NULL.
+ * @param depois tVisitaExpressao : chamada na subida, com o operando esquerdo
+ *         ja visitado. Nenhuma das visitas pode seguir o ponteiro esquerdo do
+ *         pai, que esta invertido.
+ * @param contexto void* : repassado as visitas.
+ */
+void percorrerExpressao(tExpressao raiz, tVisitaExpressao antes, tVisitaExpressao depois,
+		void *contexto) {
+
+	auto tExpressao pai = NULL, filho;
+
+	if (!raiz)
+		return;
+
+	for (;;) {
+		if (antes)
+			antes(raiz, pai, contexto);
+
+		if (!(filho = raiz->esquerda))
+			break;
+
+		raiz->esquerda = pai;
+		pai = raiz;
+		raiz = filho;
+	}
+
+	for (;;) {
+		depois(raiz, pai, contexto);
+
+		if (!pai)
+			break;
+
+		filho = raiz;
+		raiz = pai;
+		pai = raiz->esquerda;
+		raiz->esquerda = filho;
+	}
+}
+
+/**
+ * Destroi uma expressao.
+ *
+ * Desaloca todos os nos da arvore e a deixa nula. O ramo esquerdo eh
+ *  desalocado em laco.
+ *
+ * @param expressao tExpressao* : endereco da raiz.
+ */
+void destruirExpressao(tExpressao *expressao) {
+
+	auto tExpressao esquerda;
+
+	while (*expressao) {
+		destruirExpressao(&(*expressao)->direita);
+		esquerda = (*expressao)->esquerda;
+		free(*expressao);
+		*expressao = esquerda;
+	}
+}
+
+#endif /* _EXPRESSAO_H_ */
@@ -0,0 +1,97 @@
+/**
+ * Fila de dados na ordem do fonte.
+ *
+ * Guarda os identificadores de uma lista (variaveis de uma declaracao,
+ *  parametros de um grupo, argumentos de le/escreve) na ordem em que sao lidos,
+ *  para que o gerador os escreva nessa mesma ordem sem inverter uma pilha. Os
+ *  dados ficam em um vetor que cresce por dobra (vetor) e eh reaproveitado de uma lista
+ *  para a seguinte, assim cada identificador custa apenas uma copia do
+ *  registro.
+ *
+ * @see semantico
+ * @see geradorCodigo
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _FILA_H_
+#define _FILA_H_
+
+/*includes*/
+#include <stdlib.h>
+#include "padroes.h"
+#include "vetor.h"
+
+/*defines*/
+#define FILA_INICIAL 16 /*capacidade inicial da fila*/
+
+/*novos tipos*/
+/**
+ * @brief Fila de dados.
+ */
+typedef struct {
+	tDados *dado; /**dados na ordem de insercao*/
+	unsigned int total; /**numero de dados na fila*/
+	unsigned int capacidade; /**numero de dados alocados*/
+} tFila;
+
+/*funcoes e procedimentos*/
+/**
+ * Cria uma fila vazia.
+ *
+ * @param fila tFila* : endereco da fila.
+ */
+void criarFila(tFila *fila) {
+
+	fila->dado = NULL;
+	fila->total = fila->capacidade = 0;
+}
+
+/**
+ * Acrescenta um dado ao fim da fila.
+ *
+ * @param fila tFila* : endereco da fila.
+ * @param valor const tDados* : dado a acrescentar.
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+tControle inserirFila(tFila *fila, const tDados *valor) {
+
+	auto tDados *novos;
+
+	if (fila->total == fila->capacidade) {
+
+		if (!(novos = (tDados*) crescerVetor(fila->dado, &fila->capacidade, fila->total + 1,
+				FILA_INICIAL, sizeof(tDados))))
+			return ERRO;
+		fila->dado = novos;
+	}
+
+	fila->dado[fila->total++] = *valor;
+	return SUCESSO;
+}
+
+/**
+ * Esvazia a fila, mantendo a memoria para a proxima lista.
+ *
+ * @param fila tFila* : endereco da fila.
+ */
+void esvaziarFila(tFila *fila) {
+
+	fila->total = 0;
+}
+
+/**
+ * Destroi a fila.
+ *
+ * @param fila tFila* : endereco da fila.
+ */
+void destruirFila(tFila *fila) {
+
+	free(fila->dado);
+	criarFila(fila);
+}
+
+#endif /* _FILA_H_ */
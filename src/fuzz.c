@@ -0,0 +1,392 @@
+/**
+ * fuzz.c
+ *
+ * Ponto de entrada para fuzzing do compilador Equidnas (make fuzz).
+ *
+ * LLVMFuzzerTestOneInput compila cada entrada em memoria com a biblioteca
+ *  (equidnasCompilar), sem arquivos nem processos, e confere o resultado: com
+ *  sucesso deve haver codigo do tamanho informado, sem sucesso nao deve haver
+ *  codigo, e todo diagnostico deve ter mensagem. Qualquer desvio aborta, para
+ *  que o fuzzer guarde a entrada como falha. Com clang o arquivo eh ligado ao
+ *  libFuzzer, que cuida das mutacoes, da cobertura e dos relatorios:
+ *
+ *    make fuzz && ./equidnasFuzz -max_total_time=3600 corpus ../testInputs
+ *
+ * Sem libFuzzer (EQUIDNAS_FUZZ_MAIN, make fuzz-gcc) o main deste arquivo faz o
+ *  mesmo papel de forma simples: compila duas vezes cada semente, conferindo
+ *  que a segunda compilacao repete a primeira (a biblioteca nao pode guardar
+ *  estado entre chamadas), e depois aplica mutacoes aleatorias as sementes,
+ *  escrevendo periodicamente as execucoes por segundo. Se o processo receber um
+ *  sinal de falha, a entrada em execucao eh gravada em falha.alg.
+ *
+ *    equidnasFuzz [-n execucoes] [-s semente] arquivos...
+ *
+ * @see equidnas.h
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+/*sigaction, open, write e clock_gettime do main proprio (POSIX), sigaltstack (XSI)*/
+#define _XOPEN_SOURCE 700
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "equidnas.h"
+
+/*funcoes e procedimentos*/
+/**
+ * Compila uma entrada e confere o resultado.
+ *
+ * @param dados const unsigned char* : entrada, um programa ALG qualquer.
+ * @param tamanho size_t : numero de bytes da entrada.
+ * @return int : sempre zero, como pede o libFuzzer.
+ */
+int LLVMFuzzerTestOneInput(const unsigned char *dados, size_t tamanho) {
+
+	auto tResultadoEquidnas resultado;
+	register unsigned int i;
+
+	equidnasCompilar((const char*) dados, tamanho, NULL, &resultado);
+
+	if (resultado.situacao == EQUIDNAS_SUCESSO) {
+		if (!resultado.codigo || strlen(resultado.codigo) != resultado.tamanhoCodigo)
+			abort();
+	} else if (resultado.codigo)
+		abort();
+
+	for (i = 0; i < resultado.totalDiagnosticos; ++i)
+		if (!resultado.diagnosticos[i].mensagem)
+			abort();
+
+	equidnasLiberar(&resultado);
+	return 0;
+}
+
+#ifdef EQUIDNAS_FUZZ_MAIN
+
+/*includes*/
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*defines*/
+#define MAX_ENTRADA 65536 /*bytes de uma entrada mutada*/
+#define EXECUCOES_PADRAO 100000UL /*mutacoes sem a opcao -n*/
+#define INTERVALO_RELATORIO 1.0 /*segundos entre os relatorios*/
+#define PILHA_SINAIS 65536 /*bytes da pilha do tratador, que tambem atende o estouro da pilha*/
+
+/*novos tipos*/
+/**
+ * @brief Uma semente do corpus.
+ */
+typedef struct {
+	char *dados; /**conteudo do arquivo*/
+	size_t tamanho; /**bytes do arquivo*/
+} tSemente;
+
+/*variaveis globais*/
+static tSemente *sementes; /**corpus lido da linha de comando*/
+static unsigned int totalSementes; /**numero de sementes*/
+static const char *entradaAtual; /**entrada em execucao, gravada se houver falha*/
+static size_t tamanhoAtual; /**bytes da entrada em execucao*/
+static unsigned long estadoAleatorio = 2463534242UL; /**estado do gerador de numeros*/
+
+/**
+ * Trechos da linguagem inseridos pelas mutacoes, para que elas passem da
+ *  analise lexica com mais frequencia.
+ */
+static const char *dicionario[] = {
+	"programa ", "var ", " : inteiro;", " : real;", "procedimento ", "inicio ", "fim",
+	"se ", " entao ", " senao ", "enquanto ", " faca ", "le(", "escreve(", " := ",
+	"1,5", "99999999999", ";", ",", "(", ")", "{", "}", ".", "<>", "<=", ">=", "a", "b"
+};
+
+/**
+ * Numero aleatorio (xorshift), repetivel pela semente. Funcao para uso interno.
+ *
+ * @param limite unsigned long : o numero fica entre zero e limite - 1.
+ * @return unsigned long : numero sorteado, zero se o limite for zero.
+ */
+static unsigned long _sortear(unsigned long limite) {
+
+	estadoAleatorio ^= (estadoAleatorio << 13) & 0xffffffffUL;
+	estadoAleatorio ^= estadoAleatorio >> 17;
+	estadoAleatorio ^= (estadoAleatorio << 5) & 0xffffffffUL;
+
+	return limite ? estadoAleatorio % limite : 0;
+}
+
+/**
+ * Instante atual em segundos. Funcao para uso interno.
+ *
+ * @return double : tempo de um relogio monotono.
+ */
+static double _agoraFuzz(void) {
+
+	auto struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * Grava a entrada em execucao e repete o sinal, que ja voltou a acao padrao.
+ *  Funcao para uso interno.
+ *
+ * Usa apenas chamadas seguras dentro de um tratador de sinal.
+ *
+ * @param sinal int : sinal recebido.
+ */
+static void _falha(int sinal) {
+
+	static const char aviso[] = "\nFalha, entrada gravada em falha.alg\n";
+	auto int arquivo;
+
+	if ((arquivo = open("falha.alg", O_WRONLY | O_CREAT | O_TRUNC, 0644)) >= 0) {
+		if (write(arquivo, entradaAtual, tamanhoAtual) < 0)
+			;
+		close(arquivo);
+	}
+	if (write(STDERR_FILENO, aviso, sizeof(aviso) - 1) < 0)
+		;
+
+	raise(sinal);
+}
+
+/**
+ * Instala o tratador de falhas em uma pilha propria, assim ate o estouro da
+ *  pilha do compilador eh gravado. Funcao para uso interno.
+ *
+ * @return int : zero, ou 1 se a pilha do tratador nao for aceita.
+ */
+static int _tratarFalhas(void) {
+
+	static const int sinais[] = { SIGSEGV, SIGABRT, SIGFPE, SIGBUS, SIGILL };
+	static char pilhaSinais[PILHA_SINAIS];
+	auto struct sigaction acao;
+	auto stack_t pilha;
+	register unsigned int i;
+
+	pilha.ss_sp = pilhaSinais;
+	pilha.ss_size = PILHA_SINAIS;
+	pilha.ss_flags = 0;
+	if (sigaltstack(&pilha, NULL))
+		return 1;
+
+	memset(&acao, 0, sizeof(acao));
+	acao.sa_handler = _falha;
+	acao.sa_flags = SA_ONSTACK | SA_RESETHAND;
+	sigemptyset(&acao.sa_mask);
+
+	for (i = 0; i < sizeof(sinais) / sizeof(sinais[0]); ++i)
+		sigaction(sinais[i], &acao, NULL);
+	return 0;
+}
+
+/**
+ * Executa uma entrada, guardando-a para o caso de falha. Funcao para uso interno.
+ *
+ * @param dados const char* : entrada.
+ * @param tamanho size_t : bytes da entrada.
+ */
+static void _executar(const char *dados, size_t tamanho) {
+
+	entradaAtual = dados;
+	tamanhoAtual = tamanho;
+	LLVMFuzzerTestOneInput((const unsigned char*) dados, tamanho);
+}
+
+/**
+ * Le um arquivo inteiro para o corpus. Funcao para uso interno.
+ *
+ * @param nome const char* : nome do arquivo.
+ * @return int : zero, ou 1 se o arquivo nao pode ser lido.
+ */
+static int _lerSemente(const char *nome) {
+
+	auto FILE *arquivo;
+	auto tSemente *novas;
+	auto char *dados;
+	auto long tamanho;
+
+	if (!(arquivo = fopen(nome, "rb")))
+		return 1;
+
+	if (fseek(arquivo, 0, SEEK_END) || (tamanho = ftell(arquivo)) < 0
+			|| fseek(arquivo, 0, SEEK_SET) || !(dados = (char*) malloc(tamanho + 1))) {
+		fclose(arquivo);
+		return 1;
+	}
+
+	if (fread(dados, 1, tamanho, arquivo) != (size_t) tamanho
+			|| !(novas = (tSemente*) realloc(sementes, (totalSementes + 1) * sizeof(tSemente)))) {
+		free(dados);
+		fclose(arquivo);
+		return 1;
+	}
+	fclose(arquivo);
+
+	sementes = novas;
+	sementes[totalSementes].dados = dados;
+	sementes[totalSementes++].tamanho = (size_t) tamanho;
+	return 0;
+}
+
+/**
+ * Compila uma entrada duas vezes e confere que os resultados sao iguais.
+ *  Funcao para uso interno.
+ *
+ * @param semente const tSemente* : entrada.
+ */
+static void _conferirRepeticao(const tSemente *semente) {
+
+	auto tResultadoEquidnas primeiro, segundo;
+
+	entradaAtual = semente->dados;
+	tamanhoAtual = semente->tamanho;
+
+	equidnasCompilar(semente->dados, semente->tamanho, NULL, &primeiro);
+	equidnasCompilar(semente->dados, semente->tamanho, NULL, &segundo);
+
+	if (primeiro.situacao != segundo.situacao
+			|| primeiro.totalDiagnosticos != segundo.totalDiagnosticos
+			|| primeiro.tamanhoCodigo != segundo.tamanhoCodigo
+			|| (primeiro.codigo && memcmp(primeiro.codigo, segundo.codigo, primeiro.tamanhoCodigo)))
+		abort();
+
+	equidnasLiberar(&primeiro);
+	equidnasLiberar(&segundo);
+}
+
+/**
+ * Aplica uma mutacao aleatoria a entrada. Funcao para uso interno.
+ *
+ * @param entrada char* : entrada, com 2 * MAX_ENTRADA bytes alocados; a segunda
+ *         metade eh de rascunho.
+ * @param tamanho size_t : bytes ocupados.
+ * @return size_t : bytes ocupados depois da mutacao.
+ */
+static size_t _mutar(char *entrada, size_t tamanho) {
+
+	auto size_t posicao = _sortear(tamanho + 1), parte;
+	auto const char *trecho;
+	auto const tSemente *outra;
+
+	switch (_sortear(5)) {
+
+	case 0: /*troca um byte*/
+		if (tamanho)
+			entrada[posicao % tamanho] = (char) _sortear(256);
+		return tamanho;
+
+	case 1: /*apaga um trecho*/
+		parte = _sortear(16) + 1;
+		if (posicao + parte > tamanho)
+			return posicao;
+		memmove(entrada + posicao, entrada + posicao + parte, tamanho - posicao - parte);
+		return tamanho - parte;
+
+	case 2: /*insere um trecho do dicionario*/
+		trecho = dicionario[_sortear(sizeof(dicionario) / sizeof(dicionario[0]))];
+		parte = strlen(trecho);
+		break;
+
+	case 3: /*repete um trecho da propria entrada, como digitos ou nomes enormes*/
+		if (!tamanho)
+			return tamanho;
+		parte = _sortear(tamanho - posicao % tamanho) + 1;
+		trecho = entrada + posicao % tamanho;
+		break;
+
+	default: /*insere um trecho de outra semente*/
+		outra = sementes + _sortear(totalSementes);
+		if (!outra->tamanho)
+			return tamanho;
+		parte = _sortear(outra->tamanho) + 1;
+		trecho = outra->dados + _sortear(outra->tamanho - parte + 1);
+	}
+
+	if (tamanho + parte > MAX_ENTRADA)
+		return tamanho;
+
+	/*o trecho pode estar na propria entrada, por isso passa antes pela segunda metade*/
+	memcpy(entrada + MAX_ENTRADA, trecho, parte);
+	memmove(entrada + posicao + parte, entrada + posicao, tamanho - posicao);
+	memcpy(entrada + posicao, entrada + MAX_ENTRADA, parte);
+	return tamanho + parte;
+}
+
+/*programa principal*/
+/**
+ * Executa o corpus e as mutacoes.
+ */
+int main(int argc, char *argv[]) {
+
+	auto unsigned long execucoes = EXECUCOES_PADRAO, feitas;
+	auto char *entrada;
+	auto size_t tamanho;
+	auto double inicio, relatorio, agora;
+	auto const tSemente *origem;
+	register int i;
+
+	for (i = 1; i < argc; ++i)
+		if (!strcmp(argv[i], "-n") && i + 1 < argc)
+			execucoes = strtoul(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+			estadoAleatorio = strtoul(argv[++i], NULL, 10) | 1;
+		else if (_lerSemente(argv[i]))
+			fprintf(stderr, "Nao foi possivel ler %s\n", argv[i]);
+
+	if (!totalSementes) {
+		fprintf(stderr, "Use: %s [-n execucoes] [-s semente] arquivos...\n", argv[0]);
+		return 1;
+	}
+
+	/*os tratadores de falha entram antes da primeira execucao*/
+	if (!(entrada = (char*) malloc(2 * MAX_ENTRADA)) || _tratarFalhas())
+		return 1;
+
+	for (i = 0; i < (int) totalSementes; ++i)
+		_conferirRepeticao(sementes + i);
+	fprintf(stderr, "%u sementes compiladas duas vezes com o mesmo resultado\n", totalSementes);
+
+	inicio = relatorio = _agoraFuzz();
+	tamanho = 0;
+
+	for (feitas = 0; feitas < execucoes; ++feitas) {
+
+		/*de tempos em tempos recomeca de uma semente*/
+		if (!(feitas % 64)) {
+			origem = sementes + _sortear(totalSementes);
+			tamanho = origem->tamanho < MAX_ENTRADA ? origem->tamanho : MAX_ENTRADA;
+			memcpy(entrada, origem->dados, tamanho);
+		}
+
+		tamanho = _mutar(entrada, tamanho);
+		_executar(entrada, tamanho);
+
+		if ((agora = _agoraFuzz()) - relatorio >= INTERVALO_RELATORIO) {
+			fprintf(stderr, "#%lu execucoes, %.0f exec/s\n", feitas + 1,
+					(feitas + 1) / (agora - inicio));
+			relatorio = agora;
+		}
+	}
+
+	agora = _agoraFuzz();
+	fprintf(stderr, "#%lu execucoes em %.2f s, %.0f exec/s, nenhuma falha\n", feitas,
+			agora - inicio, feitas / (agora - inicio > 0 ? agora - inicio : 1));
+
+	for (i = 0; i < (int) totalSementes; ++i)
+		free(sementes[i].dados);
+	free(sementes);
+	free(entrada);
+	return 0;
+}
+
+#endif /* EQUIDNAS_FUZZ_MAIN */
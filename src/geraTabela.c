@@ -0,0 +1,459 @@
+/**
+ * geraTabela.c
+ *
+ * Gerador da tabela de analise LL(1) da linguagem ALG.
+ *
+ * Le a gramatica descrita em alg.gram, calcula os anulaveis, os primeiros e os
+ *  seguidores de cada nao terminal e monta a tabela LL(1), relatando qualquer
+ *  conflito. A saida eh um cabecalho C (tabelaLL1.h) com as producoes, a tabela
+ *  e os seguidores, utilizado pelo analisador dirigido por tabela.
+ *
+ * Use: geraTabela alg.gram tabelaLL1.h
+ *
+ * @see sintaticoTabela
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/*defines*/
+#define MAX_SIMBOLOS 128 /*numero maximo de simbolos da gramatica*/
+#define MAX_PRODUCOES 128 /*numero maximo de producoes*/
+#define MAX_LADO_DIREITO 16 /*numero maximo de simbolos em um lado direito*/
+#define MAX_NOME 64 /*tamanho maximo do nome de um simbolo*/
+
+#define TERMINAL 0
+#define NAO_TERMINAL 1
+#define ACAO 2
+
+/*novos tipos*/
+/**
+ * @brief Simbolo da gramatica.
+ */
+typedef struct {
+	char nome[MAX_NOME]; /**nome como aparece na gramatica*/
+	signed char tipo; /**TERMINAL, NAO_TERMINAL ou ACAO*/
+	int indice; /**posicao entre os simbolos do mesmo tipo*/
+} tSimbolo;
+
+/**
+ * @brief Producao da gramatica.
+ */
+typedef struct {
+	int esquerda; /**nao terminal do lado esquerdo (indice em simbolos)*/
+	int direita[MAX_LADO_DIREITO]; /**lado direito (indices em simbolos)*/
+	int tamanho; /**numero de simbolos do lado direito*/
+} tProducao;
+
+/*variaveis globais*/
+static tSimbolo simbolos[MAX_SIMBOLOS];
+static int totalSimbolos, totalTerminais, totalNaoTerminais, totalAcoes;
+static tProducao producoes[MAX_PRODUCOES];
+static int totalProducoes;
+
+/*conjuntos por nao terminal, indexados pelo indice do terminal; o terminal
+ * totalTerminais representa o final do arquivo ($)*/
+static char anulavel[MAX_SIMBOLOS];
+static char primeiros[MAX_SIMBOLOS][MAX_SIMBOLOS + 1];
+static char seguidores[MAX_SIMBOLOS][MAX_SIMBOLOS + 1];
+static int tabela[MAX_SIMBOLOS][MAX_SIMBOLOS + 1];
+
+/**
+ * Encerra o gerador com uma mensagem de erro.
+ *
+ * @param mensagem const char* : mensagem de erro.
+ * @param detalhe const char* : complemento da mensagem.
+ */
+static void falhar(const char *mensagem, const char *detalhe) {
+
+	fprintf(stderr, "geraTabela: %s %s\n", mensagem, detalhe);
+	exit(1);
+}
+
+/**
+ * Busca ou cria um simbolo.
+ *
+ * O tipo eh decidido pelo nome: maiusculas para terminais, @ para acoes e
+ *  minusculas para nao terminais.
+ *
+ * @param nome const char* : nome do simbolo.
+ * @return int : indice do simbolo em simbolos.
+ */
+static int simbolo(const char *nome) {
+
+	register int i;
+
+	for (i = 0; i < totalSimbolos; ++i)
+		if (!strcmp(simbolos[i].nome, nome))
+			return i;
+
+	if (totalSimbolos == MAX_SIMBOLOS)
+		falhar("simbolos demais, ultimo:", nome);
+
+	strcpy(simbolos[i].nome, nome);
+
+	if (nome[0] == '@')
+		simbolos[i].tipo = ACAO, simbolos[i].indice = totalAcoes++;
+	else if (isupper((unsigned char) nome[0]))
+		simbolos[i].tipo = TERMINAL, simbolos[i].indice = totalTerminais++;
+	else
+		simbolos[i].tipo = NAO_TERMINAL, simbolos[i].indice = totalNaoTerminais++;
+
+	return totalSimbolos++;
+}
+
+/**
+ * Le uma palavra da gramatica.
+ *
+ * Ignora espacos e comentarios (# ate o fim da linha). Os separadores ':', '|'
+ *  e ';' sao palavras de um caracter.
+ *
+ * @param arquivo FILE* : gramatica.
+ * @param palavra char* : palavra lida.
+ * @return int : zero no final do arquivo.
+ */
+static int lerPalavra(FILE *arquivo, char *palavra) {
+
+	register int c, i = 0;
+
+	do {
+		c = fgetc(arquivo);
+		if (c == '#')
+			while (c != '\n' && c != EOF)
+				c = fgetc(arquivo);
+	} while (isspace(c));
+
+	if (c == EOF)
+		return 0;
+
+	if (c == ':' || c == '|' || c == ';') {
+		palavra[0] = (char) c;
+		palavra[1] = '\0';
+		return 1;
+	}
+
+	while (c != EOF && !isspace(c) && c != ':' && c != '|' && c != ';' && c != '#') {
+		if (i == MAX_NOME - 1) {
+			palavra[i] = '\0';
+			falhar("nome grande demais:", palavra);
+		}
+		palavra[i++] = (char) c;
+		c = fgetc(arquivo);
+	}
+	ungetc(c, arquivo);
+	palavra[i] = '\0';
+
+	return 1;
+}
+
+/**
+ * Le a gramatica.
+ *
+ * Cada regra tem a forma "nome : alternativa | alternativa ... ;" e cada
+ *  alternativa vira uma producao.
+ *
+ * @param arquivo FILE* : gramatica.
+ */
+static void lerGramatica(FILE *arquivo) {
+
+	auto char palavra[MAX_NOME];
+	auto int esquerda;
+	auto tProducao *atual;
+
+	while (lerPalavra(arquivo, palavra)) {
+
+		esquerda = simbolo(palavra);
+		if (simbolos[esquerda].tipo != NAO_TERMINAL)
+			falhar("lado esquerdo deve ser nao terminal:", palavra);
+
+		if (!lerPalavra(arquivo, palavra) || strcmp(palavra, ":"))
+			falhar("esperava-se ':' depois de", simbolos[esquerda].nome);
+
+		do {
+			if (totalProducoes == MAX_PRODUCOES)
+				falhar("producoes demais em", simbolos[esquerda].nome);
+
+			atual = &producoes[totalProducoes++];
+			atual->esquerda = esquerda;
+			atual->tamanho = 0;
+
+			while (lerPalavra(arquivo, palavra) && strcmp(palavra, "|") && strcmp(palavra, ";")) {
+				if (atual->tamanho == MAX_LADO_DIREITO)
+					falhar("lado direito grande demais em", simbolos[esquerda].nome);
+				atual->direita[atual->tamanho++] = simbolo(palavra);
+			}
+		} while (!strcmp(palavra, "|"));
+
+		if (strcmp(palavra, ";"))
+			falhar("esperava-se ';' no final de", simbolos[esquerda].nome);
+	}
+}
+
+/**
+ * Calcula os primeiros de uma sequencia de simbolos.
+ *
+ * Acumula em conjunto os primeiros da sequencia, ignorando as acoes.
+ *
+ * @param sequencia const int* : simbolos.
+ * @param tamanho int : numero de simbolos.
+ * @param conjunto char* : conjunto de terminais de saida.
+ * @return int : diferente de zero se a sequencia eh anulavel.
+ */
+static int primeirosSequencia(const int *sequencia, int tamanho, char *conjunto) {
+
+	register int i, t;
+	auto const tSimbolo *s;
+
+	for (i = 0; i < tamanho; ++i) {
+		s = &simbolos[sequencia[i]];
+
+		if (s->tipo == TERMINAL) {
+			conjunto[s->indice] = 1;
+			return 0;
+		}
+		if (s->tipo == NAO_TERMINAL) {
+			for (t = 0; t < totalTerminais; ++t)
+				if (primeiros[s->indice][t])
+					conjunto[t] = 1;
+			if (!anulavel[s->indice])
+				return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * Calcula anulaveis, primeiros e seguidores.
+ *
+ * Itera sobre as producoes ate que nenhum conjunto mude.
+ */
+static void calcularConjuntos(void) {
+
+	register int p, i, t;
+	auto int mudou, a, b;
+	auto char novo[MAX_SIMBOLOS + 1];
+	auto tProducao *atual;
+
+	/*anulaveis e primeiros*/
+	do {
+		mudou = 0;
+		for (p = 0; p < totalProducoes; ++p) {
+			atual = &producoes[p];
+			a = simbolos[atual->esquerda].indice;
+
+			memset(novo, 0, sizeof(novo));
+			if (primeirosSequencia(atual->direita, atual->tamanho, novo) && !anulavel[a])
+				anulavel[a] = mudou = 1;
+
+			for (t = 0; t < totalTerminais; ++t)
+				if (novo[t] && !primeiros[a][t])
+					primeiros[a][t] = mudou = 1;
+		}
+	} while (mudou);
+
+	/*seguidores, o simbolo inicial eh seguido pelo final do arquivo*/
+	seguidores[simbolos[producoes[0].esquerda].indice][totalTerminais] = 1;
+
+	do {
+		mudou = 0;
+		for (p = 0; p < totalProducoes; ++p) {
+			atual = &producoes[p];
+			a = simbolos[atual->esquerda].indice;
+
+			for (i = 0; i < atual->tamanho; ++i) {
+				if (simbolos[atual->direita[i]].tipo != NAO_TERMINAL)
+					continue;
+				b = simbolos[atual->direita[i]].indice;
+
+				memset(novo, 0, sizeof(novo));
+				if (primeirosSequencia(atual->direita + i + 1, atual->tamanho - i - 1, novo))
+					for (t = 0; t <= totalTerminais; ++t)
+						if (seguidores[a][t])
+							novo[t] = 1;
+
+				for (t = 0; t <= totalTerminais; ++t)
+					if (novo[t] && !seguidores[b][t])
+						seguidores[b][t] = mudou = 1;
+			}
+		}
+	} while (mudou);
+}
+
+/**
+ * Monta a tabela LL(1).
+ *
+ * Cada celula guarda a producao mais um, zero eh erro. Duas producoes na
+ *  mesma celula sao um conflito e a gramatica nao eh LL(1).
+ */
+static void montarTabela(void) {
+
+	register int p, t;
+	auto int a, conflitos = 0;
+	auto char conjunto[MAX_SIMBOLOS + 1];
+
+	for (p = 0; p < totalProducoes; ++p) {
+		a = simbolos[producoes[p].esquerda].indice;
+
+		memset(conjunto, 0, sizeof(conjunto));
+		if (primeirosSequencia(producoes[p].direita, producoes[p].tamanho, conjunto))
+			for (t = 0; t <= totalTerminais; ++t)
+				if (seguidores[a][t])
+					conjunto[t] = 1;
+
+		for (t = 0; t <= totalTerminais; ++t)
+			if (conjunto[t]) {
+				if (tabela[a][t] && tabela[a][t] != p + 1) {
+					fprintf(stderr, "geraTabela: conflito em %s com o terminal %d\n",
+							simbolos[producoes[p].esquerda].nome, t);
+					++conflitos;
+				}
+				tabela[a][t] = p + 1;
+			}
+	}
+
+	if (conflitos)
+		falhar("a gramatica nao eh LL(1)", "");
+}
+
+/**
+ * Escreve uma lista de nomes de simbolos de um tipo.
+ *
+ * @param saida FILE* : cabecalho de saida.
+ * @param tipo int : tipo dos simbolos.
+ * @param aspas int : diferente de zero para escrever os nomes entre aspas.
+ */
+static void escreverNomes(FILE *saida, int tipo, int aspas) {
+
+	register int i, n = 0;
+
+	for (i = 0; i < totalSimbolos; ++i)
+		if (simbolos[i].tipo == tipo)
+			fprintf(saida, "%s%s%s%s", !n ? "" : n % 6 ? ", " : ",\n\t",
+					aspas ? "\"" : "", simbolos[i].nome + (tipo == ACAO), aspas ? "\"" : ""), ++n;
+}
+
+/**
+ * Escreve o cabecalho com a tabela.
+ *
+ * Terminais sao escritos com os nomes dos codigos de padroes.h, nao terminais
+ *  como LL1_BASE_NAO_TERMINAL mais seu indice e acoes como LL1_BASE_ACAO mais
+ *  seu indice. Os lados direitos sao escritos em ordem inversa, prontos para
+ *  serem empilhados.
+ *
+ * @param saida FILE* : cabecalho de saida.
+ * @param origem const char* : nome da gramatica.
+ */
+static void escreverCabecalho(FILE *saida, const char *origem) {
+
+	register int p, i, t;
+	auto int inicio = 0, n;
+	auto const tSimbolo *s;
+
+	fprintf(saida, "/**\n * tabelaLL1.h\n *\n * Tabela LL(1) da linguagem ALG gerada pelo geraTabela a partir de %s.\n"
+			" *  Nao edite este arquivo, edite a gramatica.\n *\n * @see sintaticoTabela\n */\n\n", origem);
+	fprintf(saida, "#ifndef _TABELALL1_H_\n#define _TABELALL1_H_\n\n#include \"padroes.h\"\n\n");
+
+	fprintf(saida, "#define LL1_TERMINAIS %d /*o terminal LL1_TERMINAIS eh o final do arquivo*/\n", totalTerminais);
+	fprintf(saida, "#define LL1_NAO_TERMINAIS %d\n#define LL1_ACOES %d\n#define LL1_PRODUCOES %d\n",
+			totalNaoTerminais, totalAcoes, totalProducoes);
+	fprintf(saida, "#define LL1_BASE_NAO_TERMINAL 200 /*simbolos a partir daqui sao nao terminais*/\n");
+	fprintf(saida, "#define LL1_BASE_ACAO 300 /*simbolos a partir daqui sao acoes*/\n");
+	fprintf(saida, "#define LL1_INICIAL (LL1_BASE_NAO_TERMINAL + %d)\n\n",
+			simbolos[producoes[0].esquerda].indice);
+
+	for (i = 0; i < totalSimbolos; ++i)
+		if (simbolos[i].tipo == ACAO)
+			fprintf(saida, "#define LL1_ACAO_%s %d\n", simbolos[i].nome + 1, simbolos[i].indice);
+
+	fprintf(saida, "\n/*codigo de cada coluna da tabela*/\nstatic const tCodigoToken terminaisLL1[LL1_TERMINAIS] = {\n\t");
+	escreverNomes(saida, TERMINAL, 0);
+	fprintf(saida, " };\n\nstatic const char *const naoTerminaisLL1[LL1_NAO_TERMINAIS] = {\n\t");
+	escreverNomes(saida, NAO_TERMINAL, 1);
+	fprintf(saida, " };\n");
+
+	/*lados direitos invertidos*/
+	fprintf(saida, "\n/*lados direitos das producoes, em ordem inversa*/\nstatic const short int simbolosLL1[] = {");
+	for (p = 0, n = 0; p < totalProducoes; ++p)
+		for (i = producoes[p].tamanho - 1; i >= 0; --i) {
+			s = &simbolos[producoes[p].direita[i]];
+			fprintf(saida, "%s", n++ % 8 ? " " : "\n\t");
+			if (s->tipo == TERMINAL)
+				fprintf(saida, "%s,", s->nome);
+			else
+				fprintf(saida, "%d,", (s->tipo == ACAO ? 300 : 200) + s->indice);
+		}
+	fprintf(saida, "\n\t0 };\n");
+
+	fprintf(saida, "\n/*inicio de cada producao em simbolosLL1, a ultima marca o final*/\n"
+			"static const unsigned short int producoesLL1[LL1_PRODUCOES + 1] = {");
+	for (p = 0; p <= totalProducoes; ++p) {
+		fprintf(saida, "%s%d,", p % 16 ? " " : "\n\t", inicio);
+		if (p < totalProducoes)
+			inicio += producoes[p].tamanho;
+	}
+	fprintf(saida, " };\n");
+
+	fprintf(saida, "\n/*producao mais um para cada nao terminal e terminal, zero eh erro*/\n"
+			"static const unsigned char tabelaLL1[LL1_NAO_TERMINAIS][LL1_TERMINAIS + 1] = {");
+	for (i = 0; i < totalNaoTerminais; ++i) {
+		fprintf(saida, "\n\t{");
+		for (t = 0; t <= totalTerminais; ++t)
+			fprintf(saida, "%s%d", t ? "," : "", tabela[i][t]);
+		fprintf(saida, "},");
+	}
+	fprintf(saida, "\n};\n");
+
+	fprintf(saida, "\n/*seguidores de cada nao terminal, para o modo panico*/\n"
+			"static const tConjuntoTokens seguidoresLL1[LL1_NAO_TERMINAIS] = {");
+	for (i = 0; i < totalNaoTerminais; ++i) {
+		fprintf(saida, "\n\t");
+		for (t = 0, n = 0; t < totalSimbolos; ++t)
+			if (simbolos[t].tipo == TERMINAL && seguidores[i][simbolos[t].indice])
+				fprintf(saida, "%sCONJ(%s)", !n ? "" : n % 4 ? " | " : "\n\t\t| ",
+						simbolos[t].nome), ++n;
+		fprintf(saida, "%s,", n ? "" : "0");
+	}
+	fprintf(saida, "\n};\n\n#endif /* _TABELALL1_H_ */\n");
+}
+
+/**
+ * Funcao principal do gerador.
+ */
+int main(int argc, char *argv[]) {
+
+	auto FILE *entrada, *saida;
+
+	if (argc != 3) {
+		printf("Use: %s gramatica tabela.h\n", argv[0]);
+		return 1;
+	}
+
+	if (!(entrada = fopen(argv[1], "rt")))
+		falhar("erro ao abrir", argv[1]);
+
+	lerGramatica(entrada);
+	fclose(entrada);
+
+	if (!totalProducoes)
+		falhar("gramatica vazia:", argv[1]);
+
+	calcularConjuntos();
+	montarTabela();
+
+	if (!(saida = fopen(argv[2], "wt")))
+		falhar("erro ao criar", argv[2]);
+
+	escreverCabecalho(saida, argv[1]);
+	fclose(saida);
+
+	return 0;
+}
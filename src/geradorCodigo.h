@@ -22,31 +22,122 @@
 
 /*includes*/
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "padroes.h"
+#include "vetor.h"
+#include "expressao.h"
 #include "sintatico.h"
 #include "semantico.h"
+#include "mapaFonte.h"
+#include "perfil.h"
+#include "rastro.h"
+#include "desempenho.h"
 
 /*variaveis globais*/
 static FILE *arquivo; /**Ponteiro para o arquivo destino*/
-static char nomeArqDestino[51]; /**nome do arquivo destino*/
+static const char *nomeArqDestino; /**nome do arquivo destino, vazio se o codigo nao vai para um arquivo com nome*/
 extern unsigned int contErros; /**Conta o numero de erros*/
-extern tPilhaHash temporaria; /**pilha que sera utilizada pelas declaracoes e processamentos*/
+extern tFila temporaria; /**identificadores da lista em analise, na ordem do fonte*/
+static signed char gecSuspenso; /**diferente de zero enquanto a geracao estiver suspensa*/
+static unsigned int gecExpansaoAtual; /**numero da expansao em linha em andamento, zero fora delas*/
+static const char **escritas; /**nomes que recebem valor em algum ponto do programa, ordenados*/
+static unsigned int totalEscritas; /**numero de nomes que recebem valor*/
+static signed char escritasAnalisadas; /**diferente de zero depois da analise das escritas*/
+static const char *gecProcedimentoAtual; /**nome do procedimento cujo codigo esta sendo gerado*/
+static unsigned int contadorVerdadeiro, contadorFalso; /**contadores da condicao em andamento*/
+static signed char tendenciaCondicao; /**tendencia da condicao em andamento, segundo o perfil*/
+
+/*defines*/
+#define ESCRITAS_INICIAIS 32 /*capacidade inicial do vetor de nomes que recebem valor*/
+
+/*trazendo funcao de outro modulo*/
+extern signed char semEhLocal(const char*);
+extern tCodigoToken signoToken(unsigned int);
+extern const char *lexemaToken(unsigned int);
+
+/*defines*/
+/**
+ * Condicao para gerar codigo: nenhum erro encontrado e geracao nao suspensa.
+ */
+#define GERANDO (!contErros && !gecSuspenso)
+
+/**
+ * Esvazia o buffer do arquivo destino, marcando a descarga no rastro. Funcao
+ *  para uso interno.
+ */
+static void _gecDescarregar(void) {
+
+	rastroInicio("descarga", "saida");
+	fflush(arquivo);
+	rastroFim(NULL);
+}
+
+/**
+ * Escreve o inicio do codigo gerado. Funcao para uso interno.
+ */
+static void _gecPreambulo(void) {
+
+	gecSuspenso = 0;
+	gecExpansaoAtual = 0;
+
+	fprintf(arquivo, "#include <stdio.h>\n");
+	escreverPreambuloPerfil(arquivo);
+	_gecDescarregar();
+}
 
 /**
  * Inicializa o gerador de codigo.
  *
- * Faz a abertura do arquivo destino e guarda seu nome.
+ * Faz a abertura do arquivo destino e guarda seu nome, que deve continuar
+ *  valido ate o fecharGerador.
  *
  * @param nomeArquivo const char* : nome do arquivo destino.
  */
 void gerador(const char *nomeArquivo) {
 
-	strcpy(nomeArqDestino,nomeArquivo);
+	nomeArqDestino = nomeArquivo;
 
 	arquivo = fopen(nomeArquivo,"wt");
 
-	fprintf(arquivo, "#include <stdio.h>\n");
-	fflush(arquivo);
+	_gecPreambulo();
+}
+
+/**
+ * Inicializa o gerador de codigo na saida padrao.
+ *
+ * A saida padrao pode ser um pipe: o codigo de cada declaracao eh entregue
+ *  assim que ela termina (gecFimDeclaracao) e nada eh relido, entao nao ha mapa
+ *  em JSON e o codigo ja entregue nao eh apagado se houver erros.
+ */
+void geradorSaidaPadrao(void) {
+
+	nomeArqDestino = "";
+	arquivo = stdout;
+
+	_gecPreambulo();
+}
+
+/**
+ * Inicializa o gerador de codigo em memoria.
+ *
+ * O codigo eh escrito em um bloco que cresce conforme a necessidade
+ *  (open_memstream), sem arquivo destino. O bloco e seu tamanho ficam prontos
+ *  no fecharGerador e devem ser liberados por quem chama, mesmo com erros.
+ *
+ * @param codigo char** : recebe o bloco com o codigo gerado.
+ * @param tamanho size_t* : recebe o numero de bytes do codigo.
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+tControle geradorMemoria(char **codigo, size_t *tamanho) {
+
+	nomeArqDestino = "";
+
+	if (!(arquivo = open_memstream(codigo, tamanho)))
+		return ERRO;
+
+	_gecPreambulo();
+	return SUCESSO;
 }
 
 /**
@@ -54,86 +145,361 @@ void gerador(const char *nomeArquivo) {
  *
  * Fecha o gerador de codigos, sendo que se nao houve erros entao
  *  o arquivo destino sera fechado. Caso contrario o arquivo destino
- *  eh deletado.
+ *  eh deletado. O codigo gerado em memoria nunca eh descartado aqui e a
+ *  saida padrao apenas eh esvaziada.
  */
 void fecharGerador(void) {
 
-	fclose(arquivo);
+	if (!contErros)
+		escreverContadores(arquivo, nomeArqDestino);
+
+	if (arquivo == stdout)
+		_gecDescarregar();
+	else
+		fclose(arquivo);
+
+	/*o mapa vem do arquivo pronto*/
+	if (!contErros)
+		gravarMapa(nomeArqDestino);
 
-	if (contErros)
+	free(escritas);
+	escritas = NULL;
+	totalEscritas = 0;
+	escritasAnalisadas = 0;
+
+	if (contErros && *nomeArqDestino)
 		remove(nomeArqDestino);
 }
 
+/**
+ * Termina uma declaracao.
+ *
+ * Entrega o codigo da declaracao global que acabou de ser gerada, para que a
+ *  saida padrao acompanhe a traducao em vez de esperar o fim do programa.
+ */
+void gecFimDeclaracao(void) {
+
+	_gecDescarregar();
+}
+
+/**
+ * Suspende ou retoma a geracao de codigo.
+ *
+ * Com a geracao suspensa o analisador pode passar por um trecho, como o
+ *  cabecalho de um procedimento compilado em outro processo, sem gerar codigo.
+ *
+ * @param suspender signed char : diferente de zero para suspender, zero para retomar.
+ */
+void gecSuspender(signed char suspender) {
+
+	gecSuspenso = suspender;
+}
+
+/**
+ * Troca o arquivo destino.
+ *
+ * O codigo passa a ser escrito em outro arquivo, como o arquivo temporario de
+ *  um processo da compilacao paralela.
+ *
+ * @param novo FILE* : novo arquivo destino.
+ * @return FILE* : o arquivo destino anterior.
+ */
+FILE *gecRedirecionar(FILE *novo) {
+
+	auto FILE *anterior = arquivo;
+
+	arquivo = novo;
+	return anterior;
+}
+
+/**
+ * Marca o inicio de um comando
+ *
+ * Com o mapa do codigo gerado ligado escreve a posicao do comando no fonte.
+ *
+ * @param linha unsigned int : linha do comando no fonte.
+ * @param coluna unsigned int : coluna do comando no fonte.
+ */
+void gecLinha(unsigned int linha, unsigned int coluna) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if (fonteMapa && GERANDO)
+		escreverDiretivaLinha(arquivo, linha, coluna);
+
+	MEDIR_FIM();
+}
+
+/**
+ * Define a expansao em linha em andamento.
+ *
+ * Dentro de uma expansao os nomes locais do procedimento expandido recebem o
+ *  sufixo "_numero", que nao pode aparecer em um identificador de ALG, e assim
+ *  nao colidem com os nomes do procedimento onde a expansao eh feita.
+ *
+ * @param numero unsigned int : numero da expansao, zero para nenhuma.
+ * @return unsigned int : o numero da expansao anterior.
+ */
+unsigned int gecExpansao(unsigned int numero) {
+
+	auto unsigned int anterior = gecExpansaoAtual;
+
+	gecExpansaoAtual = numero;
+	return anterior;
+}
+
+/**
+ * Sufixo de um nome.
+ *
+ * @param nome const char* : nome de uma variavel.
+ * @return unsigned int : numero da expansao cujo sufixo o nome recebe, zero se
+ *          o nome eh escrito como esta.
+ */
+unsigned int gecSufixo(const char *nome) {
+
+	return gecExpansaoAtual && semEhLocal(nome) ? gecExpansaoAtual : 0;
+}
+
+/**
+ * Escreve um nome com o sufixo de uma expansao, se houver.
+ *
+ * @param nome const char* : nome.
+ * @param sufixo unsigned int : numero da expansao, zero para nenhum.
+ */
+static void _gecNome(const char *nome, unsigned int sufixo) {
+
+	if (sufixo)
+		fprintf(arquivo, "%s_%u", nome, sufixo);
+	else
+		fprintf(arquivo, "%s", nome);
+}
+
+/**
+ * Escreve o nome de uma variavel.
+ *
+ * Na expansao de um procedimento os nomes locais recebem o sufixo da expansao.
+ *
+ * @param nome char* : nome da variavel.
+ */
+void gecIdentificador(char *nome) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if (GERANDO)
+		_gecNome(nome, gecSufixo(nome));
+
+	MEDIR_FIM();
+}
+
+/**
+ * Declara um parametro de procedimento expandido.
+ *
+ * O parametro vira uma variavel local do bloco da expansao, iniciada com o
+ *  argumento da chamada.
+ *
+ * @param tipo signed char : tipo do parametro, INTEIRO ou REAL.
+ * @param nome const char* : nome do parametro.
+ * @param argumento const char* : nome do argumento.
+ * @param sufixoArgumento unsigned int : sufixo do argumento no ponto da chamada.
+ */
+void gecDecParametroExpandido(signed char tipo, const char *nome, const char *argumento,
+		unsigned int sufixoArgumento) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if (GERANDO) {
+		fprintf(arquivo, tipo == INTEIRO ? "\nint " : "\nfloat ");
+		_gecNome(nome, gecExpansaoAtual);
+		fprintf(arquivo, " = ");
+		_gecNome(argumento, sufixoArgumento);
+		fprintf(arquivo, ";");
+	}
+
+	MEDIR_FIM();
+}
+
+/**
+ * Compara dois nomes para qsort e bsearch. Funcao para uso interno.
+ */
+static int _compararNomes(const void *a, const void *b) {
+
+	return strcmp(*(const char**) a, *(const char**) b);
+}
+
+/**
+ * Encontra os nomes que recebem valor. Funcao para uso interno.
+ *
+ * Percorre o fluxo de tokens inteiro, inclusive os procedimentos que ainda
+ *  serao analisados, guardando os nomes atribuidos e os lidos pelo comando le.
+ *  O escopo nao eh considerado: uma variavel local que recebe valor faz o nome
+ *  contar tambem para a global, o que so deixa de fora alguns const.
+ *
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+static tControle _analisarEscritas(void) {
+
+	auto unsigned int capacidade = 0;
+	auto signed char lendo = 0;
+	auto const char **novas;
+	register tCodigoToken signo;
+	register unsigned int i;
+
+	escritasAnalisadas = 1;
+
+	for (i = 0; (signo = signoToken(i)); ++i) {
+
+		if (signo == LE)
+			lendo = 1;
+		else if (signo == FECHA_PARENTESES)
+			lendo = 0;
+
+		if (signo != IDENTIFICADOR || (!lendo && signoToken(i + 1) != DOIS_PONTOS_IGUAL))
+			continue;
+
+		if (totalEscritas == capacidade) {
+
+			if (!(novas = (const char**) crescerVetor(escritas, &capacidade,
+					totalEscritas + 1, ESCRITAS_INICIAIS, sizeof(const char*))))
+				return ERRO;
+			escritas = novas;
+		}
+
+		escritas[totalEscritas++] = lexemaToken(i);
+	}
+
+	if (totalEscritas)
+		qsort(escritas, totalEscritas, sizeof(const char*), _compararNomes);
+
+	return SUCESSO;
+}
+
+/**
+ * Verifica se uma variavel global nunca recebe valor. Funcao para uso interno.
+ *
+ * @param nome const char* : nome da variavel.
+ * @return diferente de zero se a variavel pode ser declarada const.
+ */
+static signed char _somenteLeitura(const char *nome) {
+
+	if (!escritasAnalisadas && _analisarEscritas() != SUCESSO) {
+		free(escritas);
+		escritas = NULL;
+		totalEscritas = 0;
+	}
+
+	/*sem a analise nenhuma variavel eh const*/
+	if (!escritas)
+		return 0;
+
+	return !bsearch(&nome, escritas, totalEscritas, sizeof(const char*), _compararNomes);
+}
+
+/**
+ * Declara as variaveis globais de um tipo. Funcao para uso interno.
+ *
+ * Todo o programa esta em um unico arquivo, entao as variaveis sao static; as
+ *  que nunca recebem valor sao tambem const, valendo sempre zero.
+ *
+ * @param tipo signed char : INTEIRO ou REAL.
+ * @param constantes signed char : diferente de zero para declarar apenas as
+ *                                  const, zero para as demais.
+ */
+static void _gecDecGlobais(signed char tipo, signed char constantes) {
+
+	auto signed char primeira = 1;
+	register unsigned int i;
+
+	for (i = 0; i < temporaria.total; ++i) {
+
+		if (_somenteLeitura(temporaria.dado[i].nome) != constantes)
+			continue;
+
+		if (primeira)
+			fprintf(arquivo, "\nstatic %s%s %s", constantes ? "const " : "",
+					tipo == INTEIRO ? "int" : "float", temporaria.dado[i].nome);
+		else
+			fprintf(arquivo, ", %s", temporaria.dado[i].nome);
+
+		primeira = 0;
+	}
+
+	if (!primeira)
+		fprintf(arquivo, ";");
+}
+
 /**
  * Gera o codigo da declaracao de variaveis
  *
  * Traduz o codigo referente a declaracao de variaveis de um tipo por vez.
- *  Ou seja, de uma linha "var" por vez. As variaveis no cdigo alvo estao
- *  em ordem inversa devido a estrutura de dados utilizada - pilha.
+ *  Ou seja, de uma linha "var" por vez, com as variaveis na ordem do fonte.
+ *  As variaveis globais sao declaradas por _gecDecGlobais.
  *
- * @param token tToken : token com os tipos das variaveis.
+ * @param token const tToken* : token com os tipos das variaveis.
+ * @param escopo int : escopo das variaveis, zero para global.
  */
-void gecDecVar(tToken token){
+void gecDecVar(const tToken *token, int escopo){
 
-	if (!contErros) {
-		auto tPilhaHash aux = temporaria->anterior;
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if (GERANDO && !escopo) {
+		_gecDecGlobais(token->signo, 0);
+		_gecDecGlobais(token->signo, 1);
+		_gecDescarregar();
+	}
+	else if (GERANDO && temporaria.total) {
+		register unsigned int i;
 
 		/*verifica o tipo int/float e codifica a primeira variavel*/
-		if (token.signo == INTEIRO)
-			fprintf(arquivo, "\nint %s", temporaria->dado.nome);
+		if (token->signo == INTEIRO)
+			fprintf(arquivo, "\nint ");
 		else
-			fprintf(arquivo, "\nfloat %s", temporaria->dado.nome);
+			fprintf(arquivo, "\nfloat ");
+		_gecNome(temporaria.dado[0].nome, gecExpansaoAtual);
 
 		/*escreve outras as variaveis*/
-		while (aux) {
-			fprintf(arquivo, ", %s", aux->dado.nome);
-			aux = aux->anterior;
+		for (i = 1; i < temporaria.total; ++i) {
+			fprintf(arquivo, ", ");
+			_gecNome(temporaria.dado[i].nome, gecExpansaoAtual);
 		}
 
 		fprintf(arquivo, ";");
-		fflush(arquivo);
+		_gecDescarregar();
 	}
+
+	MEDIR_FIM();
 }
 
 /**
  * Gera a declaracao de argumentos.
  *
- * Este procedimento eh utilizado na declaracao de argumentos. Como estamos
- *  trabalhando com estes argumentos em uma pilha eh necessaria a inversao deles.
- *  Para isso eh utilizada outra pilha auxiliar. O procedimento declara os argumentos
- *  de um tipo por vez.
+ * Este procedimento eh utilizado na declaracao de argumentos. Os argumentos
+ *  estao na fila temporaria na ordem do fonte. O procedimento declara os
+ *  argumentos de um tipo por vez.
  *
- * @param token tToken : token com o tipo do argumento.
+ * @param token const tToken* : token com o tipo do argumento.
  */
-void gecDecArg(tToken token) {
+void gecDecArg(const tToken *token) {
 
-	if (!contErros) {
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
 
-		auto tPilhaHash auxInvertida, aux = temporaria;
+	if (GERANDO) {
 
-		criarPilha(&auxInvertida);
+		register unsigned int i;
 
-		/*invertendo a pilha*/
-		while(aux) {
-			inserirPilha(&auxInvertida,&aux->dado);
-			aux = aux->anterior;
-		}
+		for (i = 0; i < temporaria.total; ++i) {
+			if (i)
+				fprintf(arquivo, ", ");
 
-		/*pega os argumentos em ordem*/
-		while (auxInvertida) {
-			if (token.signo == INTEIRO || token.signo == NUMERO_INTEIRO)
-				fprintf(arquivo, "int %s", auxInvertida->dado.nome);
+			if (token->signo == INTEIRO || token->signo == NUMERO_INTEIRO)
+				fprintf(arquivo, "int %s", temporaria.dado[i].nome);
 			else
-				fprintf(arquivo, "float %s", auxInvertida->dado.nome);
-
-			if ((auxInvertida = auxInvertida->anterior))
-				fprintf(arquivo, ", ");
+				fprintf(arquivo, "float %s", temporaria.dado[i].nome);
 		}
 
-		fflush(arquivo);
-
-		destruirPilha(&auxInvertida);
+		_gecDescarregar();
 	}
+
+	MEDIR_FIM();
 }
 
 /**
@@ -143,8 +509,12 @@ void gecDecArg(tToken token) {
  */
 void gecAddVirgula(void){
 
-	if(!contErros)
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if(GERANDO)
 		fprintf(arquivo, ",");
+
+	MEDIR_FIM();
 }
 
 
@@ -155,8 +525,12 @@ void gecAddVirgula(void){
  */
 void gecAddPontoVirgula(){
 
-	if(!contErros)
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if(GERANDO)
 		fprintf(arquivo, ";");
+
+	MEDIR_FIM();
 }
 
 /**
@@ -168,8 +542,312 @@ void gecAddPontoVirgula(){
  */
 void gecGeraCodigo(char *string){
 
-	if(!contErros)
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if(GERANDO)
 		fprintf(arquivo, "%s", string);
+
+	MEDIR_FIM();
+}
+
+/**
+ * Inicia o cabecalho de um procedimento.
+ *
+ * Com um perfil em uso marca o procedimento muito chamado como hot e o nunca
+ *  chamado como cold. A definicao de um procedimento expansivel nao eh static:
+ *  todas as suas chamadas podem ser expandidas e o compilador C avisaria que
+ *  uma funcao static ficou sem uso.
+ *
+ * @param nome const char* : nome do procedimento.
+ * @param expansivel signed char : diferente de zero se as chamadas do
+ *         procedimento podem ser expandidas em linha.
+ */
+void gecCabecalhoProcedimento(const char *nome, signed char expansivel) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	gecProcedimentoAtual = nome;
+
+	if(GERANDO) {
+		switch (perfilProcedimento(nome)) {
+		case PROCEDIMENTO_QUENTE:
+			fprintf(arquivo, "\nEQ_QUENTE ");
+			break;
+		case PROCEDIMENTO_FRIO:
+			fprintf(arquivo, "\nEQ_FRIO ");
+			break;
+		default:
+			fprintf(arquivo, "\n");
+		}
+
+		fprintf(arquivo, expansivel ? "void " : "static void ");
+	}
+
+	MEDIR_FIM();
+}
+
+/**
+ * Marca o inicio dos comandos de um procedimento.
+ *
+ * Depois das declaracoes locais, com a instrumentacao ligada, conta a entrada
+ *  no procedimento. Os corpos expandidos em linha nao contam.
+ */
+void gecInicioCorpo(void) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if (instrumentando && GERANDO && !gecExpansaoAtual)
+		fprintf(arquivo, "\n++eq_contadores[%u];",
+				perfilContador("procedimento %s", gecProcedimentoAtual, 0, 0));
+
+	MEDIR_FIM();
+}
+
+/**
+ * Marca o inicio dos comandos do main.
+ *
+ * Com a instrumentacao ligada registra a gravacao do perfil no fim da execucao.
+ */
+void gecInicioPrincipal(void) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if (instrumentando && GERANDO)
+		fprintf(arquivo, "atexit(eq_gravarPerfil);\n");
+
+	MEDIR_FIM();
+}
+
+/**
+ * Inicia a condicao de um se ou enquanto.
+ *
+ * Escrito logo depois do parentese aberto do comando. Abre a marca de
+ *  tendencia do perfil e a contagem da condicao, fechadas por gecFimCondicao.
+ *
+ * @param comando const char* : "se" ou "enquanto".
+ * @param linha unsigned int : linha do comando no fonte.
+ * @param coluna unsigned int : coluna do comando no fonte.
+ */
+void gecInicioCondicao(const char *comando, unsigned int linha, unsigned int coluna) {
+
+	if(!GERANDO)
+		return;
+
+	tendenciaCondicao = perfilCondicao(comando, linha, coluna);
+
+	if (tendenciaCondicao == CONDICAO_VERDADEIRA)
+		fprintf(arquivo, "EQ_PROVAVEL(");
+	else if (tendenciaCondicao == CONDICAO_FALSA)
+		fprintf(arquivo, "EQ_IMPROVAVEL(");
+
+	if (instrumentando) {
+		contadorVerdadeiro = perfilContador("%s %u %u verdadeiro", comando, linha, coluna);
+		contadorFalso = perfilContador("%s %u %u falso", comando, linha, coluna);
+		fprintf(arquivo, "(");
+	}
+}
+
+/**
+ * Termina a condicao de um se ou enquanto.
+ */
+void gecFimCondicao(void) {
+
+	if(!GERANDO)
+		return;
+
+	if (instrumentando)
+		fprintf(arquivo, ") ? (++eq_contadores[%u], 1) : (++eq_contadores[%u], 0)",
+				contadorVerdadeiro, contadorFalso);
+
+	if (tendenciaCondicao != CONDICAO_NEUTRA)
+		fprintf(arquivo, ")");
+}
+
+/**
+ * Escreve um trecho de codigo pronto.
+ *
+ * Copia para o arquivo destino um trecho ja traduzido, como o codigo de um
+ *  procedimento guardado na compilacao anterior.
+ *
+ * @param trecho const char* : codigo a ser escrito.
+ * @param tamanho size_t : numero de bytes do trecho.
+ */
+void gecGeraTrecho(const char *trecho, size_t tamanho) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if(GERANDO)
+		fwrite(trecho, 1, tamanho, arquivo);
+
+	MEDIR_FIM();
+}
+
+/**
+ * Posicao no arquivo destino.
+ *
+ * Devolve quantos bytes ja foram gerados, usado para delimitar o codigo de
+ *  cada procedimento.
+ *
+ * @return long : deslocamento atual no arquivo destino.
+ */
+long gecPosicao(void) {
+
+	return ftell(arquivo);
+}
+
+static void _gecExpressao(tExpressao, signed char);
+
+/**
+ * Tipo que o contexto espera de um no do ramo esquerdo: o do pai ou, na raiz,
+ *  o pedido para a expressao. Funcao para uso interno.
+ *
+ * @param pai tExpressao : pai do no, NULL na raiz.
+ * @param contexto void* : signed char com o tipo pedido para a expressao.
+ * @return signed char : INTEIRO ou REAL.
+ */
+static signed char _gecTipoEsperado(tExpressao pai, void *contexto) {
+
+	return pai ? pai->tipo : *(signed char*) contexto;
+}
+
+/**
+ * Verifica se a conversao de inteiro para real de um no agrupa uma operacao.
+ *  Funcao para uso interno.
+ *
+ * @param expressao tExpressao : no convertido.
+ * @param tipo signed char : tipo esperado pelo contexto.
+ * @return signed char : diferente de zero se a operacao fica entre parenteses.
+ */
+static signed char _gecAgrupaConversao(tExpressao expressao, signed char tipo) {
+
+	return tipo == REAL && expressao->tipo == INTEIRO && expressao->esquerda
+			&& expressao->operador != ABRE_PARENTESES;
+}
+
+/**
+ * Escreve um numero real de ALG como float de C, trocando a virgula decimal
+ *  pelo ponto na escrita; o lexema continua o do fonte. Funcao para uso interno.
+ *
+ * @param cadeia const char* : lexema do numero.
+ */
+static void _gecReal(const char *cadeia) {
+
+	for (; *cadeia; ++cadeia)
+		putc(*cadeia == ',' ? '.' : *cadeia, arquivo);
+
+	putc('f', arquivo);
+}
+
+/**
+ * Traduz o que vem antes do operando esquerdo de um no: a conversao, a folha,
+ *  o abre parenteses ou o sinal. Funcao para uso interno.
+ *
+ * @see percorrerExpressao
+ */
+static void _gecAntesEsquerda(tExpressao expressao, tExpressao pai, void *contexto) {
+
+	/*conversao de inteiro para real, operacoes sao agrupadas*/
+	if (_gecTipoEsperado(pai, contexto) == REAL && expressao->tipo == INTEIRO) {
+
+		fprintf(arquivo, "(float)");
+
+		if (_gecAgrupaConversao(expressao, REAL))
+			fprintf(arquivo, "(");
+	}
+
+	switch (expressao->operador) {
+
+	case NUMERO_REAL:
+		_gecReal(expressao->cadeia);
+		break;
+
+	case IDENTIFICADOR:
+		_gecNome(expressao->cadeia, gecSufixo(expressao->cadeia));
+		break;
+
+	case NUMERO_INTEIRO:
+		fprintf(arquivo, "%s", expressao->cadeia);
+		break;
+
+	case ABRE_PARENTESES:
+		fprintf(arquivo, "(");
+		break;
+
+	default:
+		/*operacao unaria*/
+		if (!expressao->direita)
+			fprintf(arquivo, "%s", expressao->cadeia);
+	}
+}
+
+/**
+ * Traduz o que vem depois do operando esquerdo de um no: o fecha parenteses ou
+ *  o operador e o operando direito. Funcao para uso interno.
+ *
+ * @see percorrerExpressao
+ */
+static void _gecDepoisEsquerda(tExpressao expressao, tExpressao pai, void *contexto) {
+
+	switch (expressao->operador) {
+
+	case NUMERO_REAL:
+	case IDENTIFICADOR:
+	case NUMERO_INTEIRO:
+		break;
+
+	case ABRE_PARENTESES:
+		fprintf(arquivo, ")");
+		break;
+
+	default:
+		/*operacao unaria*/
+		if (!expressao->direita)
+			break;
+
+		fprintf(arquivo, "%s", expressao->cadeia);
+
+		/*separa sinais seguidos, como em a - -b*/
+		if (!expressao->direita->direita && expressao->direita->esquerda
+				&& expressao->direita->operador != ABRE_PARENTESES)
+			fprintf(arquivo, " ");
+
+		_gecExpressao(expressao->direita, expressao->tipo);
+	}
+
+	if (_gecAgrupaConversao(expressao, _gecTipoEsperado(pai, contexto)))
+		fprintf(arquivo, ")");
+}
+
+/**
+ * Traduz uma expressao tipada. Funcao para uso interno.
+ *
+ * @see gecExpressao
+ */
+static void _gecExpressao(tExpressao expressao, signed char tipo) {
+
+	if (GERANDO)
+		percorrerExpressao(expressao, _gecAntesEsquerda, _gecDepoisEsquerda, &tipo);
+}
+
+/**
+ * Traduz uma expressao tipada
+ *
+ * Percorre a arvore escrevendo operandos e operadores na ordem do fonte, o
+ *  ramo esquerdo em laco por percorrerExpressao. Um
+ *  operando inteiro usado onde se espera real recebe a conversao explicita
+ *  (float), os numeros reais sao escritos como float e a divisao de inteiros
+ *  permanece inteira. Nenhuma outra conversao eh inserida.
+ *
+ * @param expressao tExpressao : expressao ja tipada.
+ * @param tipo signed char : tipo esperado pelo contexto, INTEIRO ou REAL.
+ */
+void gecExpressao(tExpressao expressao, signed char tipo) {
+
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	_gecExpressao(expressao, tipo);
+
+	MEDIR_FIM();
 }
 
 /**
@@ -177,71 +855,50 @@ void gecGeraCodigo(char *string){
  *
  * ESte procedimento eh utilizado para codificar as funcoes le e escreve mapeando-as para
  *  seus equivalentes em C printf e scanf. Levando em consideracao toda a sintaxe exigida
- *  pelas funcoes em C. Para fazer a leitura na ordem correta eh necessaria a utilizacao
- *  de outra pilha para fazer a inversao dos atributos.
+ *  pelas funcoes em C. Os atributos estao na fila temporaria na ordem do fonte.
  *
  * @param ehLer char : Diferente de zero se o comando a ser mapeado eh o le, zero se for
  * 						escreve.
  */
 void gecLeEscreve(char ehLer) {
 
-	if(!contErros){
+	MEDIR_INICIO(SUBSISTEMA_GERADOR);
+
+	if(GERANDO){
+
+		register unsigned int i;
 
 		if (ehLer)
 			fprintf(arquivo, "\nscanf(\"");
 		else
 			fprintf(arquivo, "\nprintf(\"");
 
-		auto tPilhaHash aux;
-		auto tDados saida;
-
-		criarPilha(&aux);
-
-		/*eh necessaria a inversao dos dados da pilha para a leitura/escrita*/
-		while (pop(&temporaria, &saida) == SUCESSO) {
+		/*formato de cada atributo*/
+		for (i = 0; i < temporaria.total; ++i) {
 			fprintf(arquivo, " %%");
-			if(saida.tipo == INTEIRO || saida.tipo == NUMERO_INTEIRO)
+			if(temporaria.dado[i].tipo == INTEIRO || temporaria.dado[i].tipo == NUMERO_INTEIRO)
 				fprintf(arquivo, "d");
 			else
 				fprintf(arquivo, "f");
-
-			inserirPilha(&aux, &saida);
 		}
 
 		/*escrevendo membros optativos*/
 		fprintf(arquivo,"\"");
-		while (pop(&aux, &saida) == SUCESSO) {
+		for (i = 0; i < temporaria.total; ++i) {
 			if(ehLer)
-				fprintf(arquivo,", %c%s ", '&', saida.nome);
+				fprintf(arquivo,", %c", '&');
 			else
-				fprintf(arquivo,", %s ", saida.nome);
-
-			inserirPilha(&temporaria, &saida);
+				fprintf(arquivo,", ");
+			_gecNome(temporaria.dado[i].nome, gecSufixo(temporaria.dado[i].nome));
+			fprintf(arquivo," ");
 		}
 
 		/*finalizando comando*/
 		fprintf(arquivo,")");
-		fflush(arquivo);
+		_gecDescarregar();
 	}
 
-}
-
-/**
- * Converte real em ALG para C
- *
- * Faz a converso de um numero real em ALG separado por virgula para um numero
- *  real em C cujo separador  o ponto.
- */
-void gecConverteReal(tToken *token) {
-
-	register unsigned int i = 0;
-
-	if (token->signo == NUMERO_REAL)
-		while (token->cadeia[i++])
-			if (token->cadeia[i] == ',') {
-				token->cadeia[i] = '.';
-				break;
-			}
+	MEDIR_FIM();
 }
 
 #endif /* _GERADORCODIGO_H_ */
@@ -0,0 +1,639 @@
+/**
+ * incremental.h
+ *
+ * Recompilacao incremental dos procedimentos.
+ *
+ * Ao lado do arquivo destino fica um cache com o codigo C de cada procedimento,
+ *  a impressao digital dos seus tokens e as suas dependencias do escopo global,
+ *  isto eh, as variaveis e procedimentos globais que ele usa com seus tipos e
+ *  as formas das assinaturas, e a impressao digital dos procedimentos que ele
+ *  expande em linha. Na compilacao seguinte, um procedimento cujos tokens e
+ *  dependencias nao mudaram nao eh analisado nem traduzido: sua assinatura eh
+ *  declarada, seu codigo eh copiado do cache e seus tokens sao pulados.
+ * O analisador lexico continua passando pelo fonte inteiro, ja que as impressoes
+ *  sao calculadas sobre o fluxo de tokens, e o corpo principal eh sempre
+ *  compilado. O cache so eh regravado por compilacoes sem erros e so vale para
+ *  o mesmo limite de expansao em linha, com a numeracao de valores e o mapa do
+ *  codigo gerado igualmente ligados ou desligados e com o mesmo perfil de
+ *  execucao. Com o mapa ligado as impressoes tambem cobrem as posicoes dos
+ *  tokens, entao um procedimento que mudou de linha eh compilado de novo.
+ *
+ * @see sintatico
+ * @see semantico
+ * @see geradorCodigo
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _INCREMENTAL_H_
+#define _INCREMENTAL_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "semantico.h"
+#include "geradorCodigo.h"
+#include "expansao.h"
+#include "otimizador.h"
+#include "mapaFonte.h"
+#include "perfil.h"
+
+/*defines*/
+#define CABECALHO_CACHE "equidnas-cache 8\n" /*primeira linha do arquivo de cache*/
+#define EXTENSAO_CACHE ".cache" /*acrescentada ao nome do arquivo destino*/
+#define PROCEDIMENTOS_INICIAIS 16 /*capacidade inicial das listas de procedimentos*/
+#define DEPENDENCIAS_INICIAIS 8 /*capacidade inicial das dependencias de um procedimento*/
+#define FORMA_VAZIA "-" /*forma gravada no cache para assinaturas sem parametros*/
+#define PALAVRA_INICIAL 32 /*capacidade inicial de um nome ou forma lido do cache*/
+
+/*trazendo funcao de outro modulo*/
+extern unsigned int getIndiceToken(void);
+extern void irParaToken(unsigned int);
+extern const char *lexemaToken(unsigned int);
+extern tChave impressaoTokens(unsigned int, unsigned int);
+extern tControle getToken(tToken*);
+extern unsigned int contErros;
+
+/*novos tipos*/
+/**
+ * @brief Identificador global usado por um procedimento.
+ *
+ * Se o identificador deixar de existir ou mudar de tipo ou de assinatura, o
+ *  procedimento precisa ser compilado de novo.
+ */
+typedef struct {
+	char *nome; /**nome do identificador*/
+	signed char tipo; /**tipo da variavel ou PROCEDIMENTO*/
+	char *forma; /**forma da assinatura, se for procedimento*/
+	tChave impressao; /**impressao do procedimento se ele eh expansivel, senao zero*/
+} tDependencia;
+
+/**
+ * @brief Um procedimento no cache.
+ *
+ * Os procedimentos lidos do cache trazem seu codigo; os desta compilacao trazem
+ *  o trecho do arquivo destino onde o codigo foi gerado.
+ */
+typedef struct {
+	char *nome; /**nome do procedimento*/
+	tChave impressao; /**impressao digital dos tokens do procedimento*/
+	unsigned int tokens; /**numero de tokens, da palavra procedimento ao ponto-e-virgula final*/
+	char *forma; /**forma da assinatura*/
+	tDependencia *dependencias; /**identificadores globais usados*/
+	unsigned int totalDependencias; /**numero de dependencias*/
+	char *codigo; /**codigo C lido do cache, NULL depois de reaproveitado*/
+	long inicio; /**inicio do codigo no arquivo destino*/
+	long fim; /**fim do codigo no arquivo destino*/
+} tProcedimentoCache;
+
+/**
+ * @brief Lista de procedimentos, na ordem do fonte.
+ */
+typedef struct {
+	tProcedimentoCache *procedimento; /**vetor de procedimentos*/
+	unsigned int total; /**numero de procedimentos*/
+	unsigned int capacidade; /**numero de procedimentos alocados*/
+} tListaCache;
+
+/*variaveis globais*/
+static signed char incrementalAtivo; /**diferente de zero se a compilacao eh incremental*/
+static char *nomeDestinoCache; /**nome do arquivo destino*/
+static char *nomeCache; /**nome do arquivo de cache*/
+static tListaCache anteriores; /**procedimentos da compilacao anterior*/
+static tListaCache atuais; /**procedimentos desta compilacao*/
+static unsigned int proximoAnterior; /**onde comecar a procurar o proximo procedimento anterior*/
+static signed char gravandoDependencias; /**diferente de zero durante a analise de um procedimento*/
+static unsigned int inicioTokens; /**primeiro token do procedimento em analise*/
+static long inicioCodigo; /**inicio do codigo do procedimento em analise*/
+static tDependencia *dependencias; /**dependencias do procedimento em analise*/
+static unsigned int totalDependencias; /**numero de dependencias do procedimento em analise*/
+static unsigned int capacidadeDependencias; /**numero de dependencias alocadas*/
+
+/*funcoes e procedimentos*/
+/**
+ * Copia uma cadeia para a memoria dinamica. Funcao para uso interno.
+ *
+ * @param cadeia const char* : cadeia a ser copiada.
+ * @return copia da cadeia ou NULL se faltar memoria.
+ */
+static char *_copiarCadeia(const char *cadeia) {
+
+	auto char *copia = (char*) malloc(strlen(cadeia) + 1);
+
+	if (copia)
+		strcpy(copia, cadeia);
+
+	return copia;
+}
+
+/**
+ * Libera as dependencias de um procedimento. Funcao para uso interno.
+ *
+ * @param vetor tDependencia* : dependencias.
+ * @param total unsigned int : numero de dependencias.
+ */
+static void _liberarDependencias(tDependencia *vetor, unsigned int total) {
+
+	register unsigned int i;
+
+	for (i = 0; i < total; ++i) {
+		free(vetor[i].nome);
+		free(vetor[i].forma);
+	}
+
+	free(vetor);
+}
+
+/**
+ * Libera uma lista de procedimentos. Funcao para uso interno.
+ *
+ * @param lista tListaCache* : lista a ser liberada.
+ */
+static void _liberarLista(tListaCache *lista) {
+
+	register unsigned int i;
+
+	for (i = 0; i < lista->total; ++i) {
+		free(lista->procedimento[i].nome);
+		free(lista->procedimento[i].forma);
+		free(lista->procedimento[i].codigo);
+		_liberarDependencias(lista->procedimento[i].dependencias,
+				lista->procedimento[i].totalDependencias);
+	}
+
+	free(lista->procedimento);
+	memset(lista, 0, sizeof(tListaCache));
+}
+
+/**
+ * Acrescenta um procedimento vazio ao final de uma lista, que cresce dobrando
+ *  de tamanho. Funcao para uso interno.
+ *
+ * @param lista tListaCache* : lista de procedimentos.
+ * @return o novo procedimento ou NULL se faltar memoria.
+ */
+static tProcedimentoCache *_novoProcedimento(tListaCache *lista) {
+
+	auto tProcedimentoCache *novo;
+
+	if (lista->total == lista->capacidade) {
+
+		if (!(novo = (tProcedimentoCache*) crescerVetor(lista->procedimento, &lista->capacidade,
+				lista->total + 1, PROCEDIMENTOS_INICIAIS, sizeof(tProcedimentoCache))))
+			return NULL;
+		lista->procedimento = novo;
+	}
+
+	novo = &lista->procedimento[lista->total++];
+	memset(novo, 0, sizeof(tProcedimentoCache));
+
+	return novo;
+}
+
+/**
+ * Le do cache uma palavra de qualquer tamanho, como um nome ou uma forma,
+ *  pulando os espacos antes dela. Funcao para uso interno.
+ *
+ * @param cache FILE* : arquivo de cache aberto.
+ * @return palavra alocada, ou NULL no fim do arquivo ou se faltar memoria.
+ */
+static char *_lerPalavra(FILE *cache) {
+
+	auto char *palavra = NULL, *nova;
+	auto size_t tamanho = 0, capacidade = 0;
+	register int c;
+
+	do
+		c = fgetc(cache);
+	while (c != EOF && isspace(c));
+
+	for (; c != EOF && !isspace(c); c = fgetc(cache)) {
+
+		if (tamanho + 1 >= capacidade) {
+
+			capacidade = capacidade ? 2 * capacidade : PALAVRA_INICIAL;
+
+			if (!(nova = (char*) realloc(palavra, capacidade))) {
+				free(palavra);
+				return NULL;
+			}
+			palavra = nova;
+		}
+
+		palavra[tamanho++] = (char) c;
+	}
+
+	/*o espaco que terminou a palavra fica para a proxima leitura*/
+	if (c != EOF)
+		ungetc(c, cache);
+	if (palavra)
+		palavra[tamanho] = '\0';
+
+	return palavra;
+}
+
+/**
+ * Le a forma de uma assinatura do cache. Funcao para uso interno.
+ *
+ * @param cache FILE* : arquivo de cache aberto.
+ * @return forma alocada, vazia se foi gravada como FORMA_VAZIA, ou NULL se nao
+ *          foi possivel le-la.
+ */
+static char *_lerForma(FILE *cache) {
+
+	auto char *forma = _lerPalavra(cache);
+
+	if (forma && !strcmp(forma, FORMA_VAZIA))
+		*forma = '\0';
+
+	return forma;
+}
+
+/**
+ * Le o arquivo de cache.
+ *
+ * Depois do cabecalho vem o limite de expansao em linha, se a numeracao de
+ *  valores e o mapa estao ligados e a impressao do perfil de execucao. Cada
+ *  procedimento ocupa uma linha "nome impressao tokens forma dependencias
+ *  tamanho", seguida de uma linha "nome tipo forma impressao" por dependencia e
+ *  do codigo C com o tamanho indicado. Funcao para uso interno.
+ *
+ * @param cache FILE* : arquivo de cache aberto.
+ * @return SUCESSO se o cache inteiro foi lido.
+ */
+static tControle _lerCache(FILE *cache) {
+
+	auto char *nome, cabecalho[sizeof(CABECALHO_CACHE)];
+	auto unsigned long alta, baixa;
+	auto long tamanho;
+	auto unsigned int total, limite;
+	auto int tipo, otimizacao, mapa;
+	auto tProcedimentoCache *proc;
+	register unsigned int i;
+
+	if (!fgets(cabecalho, sizeof(cabecalho), cache) || strcmp(cabecalho, CABECALHO_CACHE)
+			|| fscanf(cache, "%u %d %d %lx %lx", &limite, &otimizacao, &mapa, &alta, &baixa) != 5
+			|| limite != limiteExpansao || otimizacao != otimizacaoAtiva || mapa != !!fonteMapa
+			|| ((tChave) alta << 32 | baixa) != impressaoPerfil)
+		return ERRO;
+
+	while ((nome = _lerPalavra(cache))) {
+
+		if (!(proc = _novoProcedimento(&anteriores))) {
+			free(nome);
+			return ERRO;
+		}
+		proc->nome = nome;
+
+		if (fscanf(cache, "%lx %lx %u", &alta, &baixa, &proc->tokens) != 3
+				|| !(proc->forma = _lerForma(cache))
+				|| fscanf(cache, "%u %ld", &total, &tamanho) != 2
+				|| tamanho < 0 || fgetc(cache) != '\n')
+			return ERRO;
+
+		proc->impressao = (tChave) alta << 32 | baixa;
+
+		if (total) {
+
+			if (!(proc->dependencias = (tDependencia*) calloc(total, sizeof(tDependencia))))
+				return ERRO;
+			proc->totalDependencias = total;
+
+			for (i = 0; i < proc->totalDependencias; ++i) {
+
+				if (!(proc->dependencias[i].nome = _lerPalavra(cache))
+						|| fscanf(cache, "%d", &tipo) != 1
+						|| !(proc->dependencias[i].forma = _lerForma(cache))
+						|| fscanf(cache, "%lx %lx", &alta, &baixa) != 2)
+					return ERRO;
+
+				proc->dependencias[i].impressao = (tChave) alta << 32 | baixa;
+				proc->dependencias[i].tipo = (signed char) tipo;
+			}
+
+			if (fgetc(cache) != '\n')
+				return ERRO;
+		}
+
+		/*o codigo lido ocupa o trecho de zero a tamanho*/
+		proc->fim = tamanho;
+		if (!(proc->codigo = (char*) malloc(tamanho + 1))
+				|| fread(proc->codigo, 1, tamanho, cache) != (size_t) tamanho
+				|| fgetc(cache) != '\n')
+			return ERRO;
+	}
+
+	return feof(cache) ? SUCESSO : ERRO;
+}
+
+/**
+ * Inicia a compilacao incremental.
+ *
+ * Le o cache da compilacao anterior, se existir. Um cache ilegivel eh ignorado
+ *  e todos os procedimentos sao compilados.
+ *
+ * @param nomeDestino const char* : nome do arquivo destino.
+ */
+void iniciarIncremental(const char *nomeDestino) {
+
+	auto FILE *cache;
+
+	incrementalAtivo = 1;
+	proximoAnterior = 0;
+	gravandoDependencias = 0;
+
+	nomeDestinoCache = _copiarCadeia(nomeDestino);
+	if (!nomeDestinoCache || !(nomeCache = (char*) malloc(strlen(nomeDestino) + sizeof(EXTENSAO_CACHE)))) {
+		incrementalAtivo = 0;
+		return;
+	}
+
+	strcpy(nomeCache, nomeDestino);
+	strcat(nomeCache, EXTENSAO_CACHE);
+
+	if ((cache = fopen(nomeCache, "rb"))) {
+		if (_lerCache(cache) != SUCESSO)
+			_liberarLista(&anteriores);
+		fclose(cache);
+	}
+}
+
+/**
+ * Registra uma dependencia.
+ *
+ * Chamado pelo analisador semantico quando encontra um identificador no escopo
+ *  global. Fora de um procedimento ou se a dependencia ja foi registrada nada
+ *  eh feito.
+ *
+ * @param dados const tDados* : dados do identificador global.
+ */
+void incRegistrarDependencia(const tDados *dados) {
+
+	auto tDependencia *nova;
+	register unsigned int i;
+
+	if (!gravandoDependencias)
+		return;
+
+	for (i = 0; i < totalDependencias; ++i)
+		if (!strcmp(dependencias[i].nome, dados->nome))
+			return;
+
+	if (totalDependencias == capacidadeDependencias) {
+
+		if (!(nova = (tDependencia*) crescerVetor(dependencias, &capacidadeDependencias,
+				totalDependencias + 1, DEPENDENCIAS_INICIAIS, sizeof(tDependencia)))) {
+			incrementalAtivo = 0;
+			return;
+		}
+		dependencias = nova;
+	}
+
+	if (!(dependencias[totalDependencias].nome = _copiarCadeia(dados->nome))) {
+		incrementalAtivo = 0;
+		return;
+	}
+
+	/*genI so tem significado nos procedimentos*/
+	dependencias[totalDependencias].tipo = dados->tipo;
+	dependencias[totalDependencias].impressao = dados->tipo == PROCEDIMENTO ? expImpressao(dados->nome) : 0;
+	if (!(dependencias[totalDependencias].forma = _copiarCadeia(dados->tipo == PROCEDIMENTO
+			? formaAssinatura(dados->genI) : ""))) {
+		free(dependencias[totalDependencias].nome);
+		incrementalAtivo = 0;
+		return;
+	}
+	++totalDependencias;
+}
+
+/**
+ * Tenta reaproveitar um procedimento da compilacao anterior.
+ *
+ * Chamado com o token procedimento. Procura no cache um procedimento de mesmo
+ *  nome, com a mesma impressao digital e cujas dependencias continuam iguais no
+ *  escopo global. Se encontrar declara a assinatura, copia o codigo, pula os
+ *  tokens e le o token seguinte ao procedimento.
+ *
+ * @param token tToken* : token procedimento, recebe o token seguinte.
+ * @return SUCESSO se o procedimento foi reaproveitado, FIM_ARQ_PREMATURO se
+ *          reaproveitou mas os tokens acabaram, ERRO se deve ser compilado.
+ */
+tControle incReaproveitar(tToken *token) {
+
+	auto unsigned int inicio = getIndiceToken() - 1, indice = 0;
+	auto const char *nome = lexemaToken(inicio + 1);
+	auto tProcedimentoCache *proc = NULL, *novo;
+	auto tDados dados;
+	register unsigned int i;
+
+	if (!incrementalAtivo || !nome)
+		return ERRO;
+
+	/*os procedimentos costumam estar na mesma ordem, a busca comeca pelo seguinte
+	 * ao ultimo reaproveitado*/
+	for (i = 0; i < anteriores.total && !proc; ++i) {
+		indice = (proximoAnterior + i) % anteriores.total;
+		if (anteriores.procedimento[indice].codigo
+				&& !strcmp(anteriores.procedimento[indice].nome, nome))
+			proc = &anteriores.procedimento[indice];
+	}
+
+	if (!proc || !lexemaToken(inicio + proc->tokens)
+			|| impressaoTokens(inicio, proc->tokens) != proc->impressao)
+		return ERRO;
+
+	for (i = 0; i < proc->totalDependencias; ++i)
+		if (buscarArvore(escopoGlobal, proc->dependencias[i].nome, &dados) != SUCESSO
+				|| dados.tipo != proc->dependencias[i].tipo
+				|| (dados.tipo == PROCEDIMENTO
+						&& (strcmp(formaAssinatura(dados.genI), proc->dependencias[i].forma)
+								|| expImpressao(dados.nome) != proc->dependencias[i].impressao)))
+			return ERRO;
+
+	if (!(novo = _novoProcedimento(&atuais)))
+		return ERRO;
+
+	semDeclareAssinatura(proc->nome, internarAssinatura(proc->forma, strlen(proc->forma)));
+	expRegistrar(inicio, inicio + proc->tokens);
+
+	novo->inicio = gecPosicao();
+	gecGeraTrecho(proc->codigo, (size_t) proc->fim);
+	novo->fim = gecPosicao();
+
+	/*o procedimento passa para a lista desta compilacao*/
+	novo->nome = proc->nome;
+	novo->impressao = proc->impressao;
+	novo->tokens = proc->tokens;
+	novo->forma = proc->forma;
+	novo->dependencias = proc->dependencias;
+	novo->totalDependencias = proc->totalDependencias;
+
+	free(proc->codigo);
+	proc->nome = proc->forma = proc->codigo = NULL;
+	proc->dependencias = NULL;
+	proc->totalDependencias = 0;
+	proximoAnterior = indice + 1;
+
+	irParaToken(inicio + proc->tokens);
+
+	return getToken(token) == SUCESSO ? SUCESSO : FIM_ARQ_PREMATURO;
+}
+
+/**
+ * Marca o inicio da analise de um procedimento.
+ *
+ * Chamado com o token procedimento, antes de qualquer codigo ser gerado.
+ */
+void incInicioProcedimento(void) {
+
+	if (!incrementalAtivo)
+		return;
+
+	_liberarDependencias(dependencias, totalDependencias);
+	dependencias = NULL;
+	totalDependencias = capacidadeDependencias = 0;
+
+	inicioTokens = getIndiceToken() - 1;
+	inicioCodigo = gecPosicao();
+	gravandoDependencias = 1;
+}
+
+/**
+ * Marca o fim da analise de um procedimento.
+ *
+ * Chamado com o token seguinte ao procedimento. Se nao houve erros o
+ *  procedimento entra na lista desta compilacao com suas dependencias.
+ *
+ * @param nome char* : nome do procedimento.
+ */
+void incFimProcedimento(char *nome) {
+
+	auto tProcedimentoCache *novo;
+	auto tDados dados;
+
+	if (!incrementalAtivo || !gravandoDependencias)
+		return;
+
+	gravandoDependencias = 0;
+
+	if (contErros || buscarArvore(escopoGlobal, nome, &dados) != SUCESSO
+			|| !(novo = _novoProcedimento(&atuais))) {
+		_liberarDependencias(dependencias, totalDependencias);
+		dependencias = NULL;
+		totalDependencias = capacidadeDependencias = 0;
+		return;
+	}
+
+	if (!(novo->nome = _copiarCadeia(nome)) || !(novo->forma = _copiarCadeia(formaAssinatura(dados.genI)))) {
+		incrementalAtivo = 0;
+		return;
+	}
+
+	novo->tokens = getIndiceToken() - 1 - inicioTokens;
+	novo->impressao = impressaoTokens(inicioTokens, novo->tokens);
+	novo->dependencias = dependencias;
+	novo->totalDependencias = totalDependencias;
+	novo->inicio = inicioCodigo;
+	novo->fim = gecPosicao();
+
+	dependencias = NULL;
+	totalDependencias = capacidadeDependencias = 0;
+}
+
+/**
+ * Grava o cache desta compilacao.
+ *
+ * O codigo de cada procedimento eh lido de volta do arquivo destino, ja fechado
+ *  pelo gerador. Funcao para uso interno.
+ *
+ * @return SUCESSO se o cache foi gravado.
+ */
+static tControle _gravarCache(void) {
+
+	auto FILE *destino, *cache;
+	auto tProcedimentoCache *proc;
+	auto tControle erro = SUCESSO;
+	register unsigned int i, k;
+	register long j;
+	register int c;
+
+	if (!(destino = fopen(nomeDestinoCache, "rb")))
+		return ERRO;
+	if (!(cache = fopen(nomeCache, "wb"))) {
+		fclose(destino);
+		return ERRO;
+	}
+
+	fputs(CABECALHO_CACHE, cache);
+	fprintf(cache, "%u %d %d %lx %lx\n", limiteExpansao, otimizacaoAtiva, !!fonteMapa,
+			(unsigned long) (impressaoPerfil >> 32), (unsigned long) (impressaoPerfil & 0xffffffffUL));
+
+	for (i = 0; i < atuais.total && erro == SUCESSO; ++i) {
+
+		proc = &atuais.procedimento[i];
+
+		fprintf(cache, "%s %lx %lx %u %s %u %ld\n", proc->nome,
+				(unsigned long) (proc->impressao >> 32),
+				(unsigned long) (proc->impressao & 0xffffffffUL), proc->tokens,
+				*proc->forma ? proc->forma : FORMA_VAZIA, proc->totalDependencias,
+				proc->fim - proc->inicio);
+
+		for (k = 0; k < proc->totalDependencias; ++k)
+			fprintf(cache, "%s %d %s %lx %lx\n", proc->dependencias[k].nome,
+					(int) proc->dependencias[k].tipo,
+					*proc->dependencias[k].forma ? proc->dependencias[k].forma : FORMA_VAZIA,
+					(unsigned long) (proc->dependencias[k].impressao >> 32),
+					(unsigned long) (proc->dependencias[k].impressao & 0xffffffffUL));
+
+		if (fseek(destino, proc->inicio, SEEK_SET))
+			erro = ERRO;
+
+		for (j = proc->inicio; j < proc->fim && erro == SUCESSO; ++j)
+			if ((c = fgetc(destino)) == EOF)
+				erro = ERRO;
+			else
+				fputc(c, cache);
+
+		fputc('\n', cache);
+	}
+
+	fclose(destino);
+	if (fclose(cache) || erro != SUCESSO) {
+		remove(nomeCache);
+		return ERRO;
+	}
+
+	return SUCESSO;
+}
+
+/**
+ * Encerra a compilacao incremental.
+ *
+ * Deve ser chamado depois de fechado o gerador. Se a compilacao nao teve erros
+ *  o cache eh regravado, senao o da compilacao anterior eh mantido.
+ */
+void fecharIncremental(void) {
+
+	if (incrementalAtivo && !contErros)
+		_gravarCache();
+
+	_liberarLista(&anteriores);
+	_liberarLista(&atuais);
+	_liberarDependencias(dependencias, totalDependencias);
+	free(nomeDestinoCache);
+	free(nomeCache);
+
+	dependencias = NULL;
+	totalDependencias = capacidadeDependencias = 0;
+	nomeDestinoCache = nomeCache = NULL;
+	incrementalAtivo = 0;
+}
+
+#endif /* _INCREMENTAL_H_ */
@@ -4,6 +4,13 @@
  * Biblioteca que compreende funcoes referentes ao analisador lexico
  *  para a linguagem ALG.
  *
+ * O codigo-fonte eh lido inteiro para a memoria e o analisador lexico o
+ *  percorre de uma so vez, produzindo um fluxo de tokens empacotado (tFluxoTokens).
+ *  O analisador sintatico consome este fluxo atravez de um indice, sem copiar
+ *  as cadeias dos tokens. Depois da analise lexica o fonte nao eh mais
+ *  necessario e eh liberado: tudo o que os outros modulos leem dele esta no
+ *  fluxo e no bloco de lexemas.
+ *
  * Construcao de compiladores dois
  * Helena de Medeiros Caseli
  *
@@ -22,36 +29,61 @@
 #include <stdlib.h>
 #include <string.h>
 #include "padroes.h"
+#include "espalhamento.h"
+#include "diagnosticos.h"
+#include "desempenho.h"
+#include "memoria.h"
 #include "sintatico.h"
 
 /*define*/
+/**
+ * Macro que le um caracter do fonte em memoria para a variavel c, resulta em
+ *  zero quando o fonte terminou. Mesmo no final do fonte o cabecote eh avancado,
+ *  para que RETROCEDER() sempre desfaca exatamente uma leitura.
+ */
+#define LER(c)          (posicao < tamanhoFonte ? ((c) = fonte[posicao++], 1) : (++posicao, 0))
+
 /**
  * Macro que retrocede o "cabecote de leitura" um byte (char), utilizada para
  *  recomecar o processamento de um item. Usada apenas neste bloco (.h)
  */
-#define RETROCEDER()    fseek(arqOrigem,-1,SEEK_CUR);
+#define RETROCEDER()    --posicao;
+
+#define BLOCO_LEITURA 4096 /*bytes lidos do arquivo origem por vez*/
+#define TOKENS_INICIAIS 1024 /*capacidade inicial do fluxo de tokens*/
+#define TOKENS_POR_CONFERENCIA 65536 /*tokens entre duas conferencias do limite de memoria*/
 
 /*variavel global estatica (vista apenas neste bloco .h)*/
-static FILE *arqOrigem; /**para abrir o codigo-fonte de origem*/
+static const char *fonte; /**codigo-fonte de origem inteiro em memoria, apenas durante a analise lexica*/
+static unsigned int tamanhoFonte; /**numero de bytes do codigo-fonte*/
+static unsigned int posicao; /**cabecote de leitura sobre o fonte*/
 static unsigned int linhaAtual; /**contagem de linhas*/
+static unsigned int colunaAtual; /**coluna do ultimo token entregue ao sintatico*/
+static unsigned int inicioLinha; /**deslocamento do primeiro caracter da linha atual*/
+static char *lexemas; /**cadeias dos tokens, cada uma terminada por '\0'*/
+static unsigned int tamanhoLexemas; /**bytes ocupados no bloco de lexemas*/
+static tFluxoTokens fluxo; /**tokens produzidos pelo analisador lexico*/
+static unsigned int cursor; /**indice do proximo token entregue ao sintatico*/
+static signed char posicoesNaImpressao; /**diferente de zero se linhas e colunas entram na impressao*/
 
 /*funcoes e procedimentos*/
 
 /**
- * tCodigoTokeb buscarPalavraReservada(const char*);
+ * tCodigoToken buscarPalavraReservada(const char*, unsigned int);
  *
  * Faz uma busca na tabela de palavras reservadas usando o principio de dividir
  *  e conquistar, assim como em uma avl. A busca eh feita verificado se o
  *  elemento do meio eh maior ou nao que o elemento buscado e assim orienta a
  *  proxima etapa de busca. Sendo para tanto sua complexidade algoritmica O(lg n).
  *
- * @param palavra: const char* palavra a ser buscada.
+ * @param palavra: const char* palavra a ser buscada, nao precisa terminar em '\0'.
+ * @param tamanho: unsigned int numero de caracteres da palavra.
  * @return zero se nao encontrou.
  */
-tCodigoToken buscarPalavraReservada(const char *palavra) {
+tCodigoToken buscarPalavraReservada(const char *palavra, unsigned int tamanho) {
 
       auto short unsigned int superior = TOTAL_DE_RESERVADAS, inferior = 0; /*limites da busca*/
-      auto short signed int meio, comparacao, meioAntigo = !meio;
+      auto short signed int meio = -1, comparacao, meioAntigo = 0;
 
       while(meioAntigo != meio) {
 
@@ -59,7 +91,11 @@ tCodigoToken buscarPalavraReservada(const char *palavra) {
              /*encontrando o meio levando em consideracao os limites atuais*/
              meio = (short int)(0.5 * (float)superior + 0.5 * (float) inferior);
 
-             comparacao = strcmp(palavra, tabelaPalavrasReservadas[meio]);
+             comparacao = strncmp(palavra, tabelaPalavrasReservadas[meio], tamanho);
+
+             /*palavra eh prefixo da reservada, logo fica antes dela*/
+             if(!comparacao && tabelaPalavrasReservadas[meio][tamanho] != '\0')
+                    comparacao = -1;
 
              /*palavra mais a direita*/
              if(comparacao < 0)
@@ -75,335 +111,676 @@ tCodigoToken buscarPalavraReservada(const char *palavra) {
 }
 
 /**
- * tControle iniciarAnalisadorLexico(const char*);
+ * tControle carregarFonte(FILE*);
  *
- * Funcao tem por finalidade abrir o arquivo que o analisador lexico utilizara,
- *  o nome do proposto arquivo eh recebido como parametro, se nao houve erros
- *  eh retornado SUCESSO, caso contrario ERRO_AO_ABRIR_ORIGEM (caso o arquivo
- *  nao exista ou falhe ao abrir).
+ * Le todo o conteudo do arquivo para o bloco fonte, em pedacos de BLOCO_LEITURA
+ *  bytes, de modo que nao eh necessario conhecer o tamanho do arquivo antes.
  *
- * @param nomeArquivo: char* recebe o nome do arquivo origem
- * @return tControle SUCESSO ou ERRO_AO_ABRI_ORIGEM
+ * @param arquivo FILE* : arquivo aberto com o codigo-fonte.
+ * @return tControle SUCESSO ou ERRO_AO_ABRIR_ORIGEM se faltar memoria.
  */
-tControle iniciarAnalisadorLexico(const char *nomeArquivo) {
+tControle carregarFonte(FILE *arquivo) {
 
-       linhaAtual = 1;
-       return !(arqOrigem = fopen(nomeArquivo, "rt")) ? ERRO_AO_ABRIR_ORIGEM : SUCESSO;
-}
+      auto unsigned int capacidade = BLOCO_LEITURA, lidos;
+      auto char *bloco, *novo;
 
-/**
- * void fecharAnalisadorLexico(void);
- *
- * Funcao tem por finalidade fechar o arquivo que o analisador lexico utilizou.
- */
-void fecharAnalisadorLexico(void) {
+      tamanhoFonte = 0;
+      if(!(fonte = bloco = (char*) malloc(capacidade)))
+             return ERRO_AO_ABRIR_ORIGEM;
+
+      while((lidos = fread(bloco + tamanhoFonte, sizeof(char),
+                           capacidade - tamanhoFonte, arquivo)) > 0) {
+
+             tamanhoFonte += lidos;
+
+             /*bloco cheio, dobra a capacidade*/
+             if(tamanhoFonte == capacidade) {
+                    if(!(novo = (char*) realloc(bloco, capacidade *= 2)))
+                           return ERRO_AO_ABRIR_ORIGEM;
+                    fonte = bloco = novo;
+             }
+      }
 
-      fclose(arqOrigem);
+      return SUCESSO;
 }
 
 /**
- * unsigned int getLinhaAtual(void);
+ * tControle anexarToken(tCodigoToken, unsigned int, unsigned int, unsigned int);
  *
- * Funcao retorna o numero da linha que se encontra o token atual.
+ * Coloca no final do fluxo o token que ocupa os caracteres de inicio ate o
+ *  cabecote de leitura, copiando sua cadeia para o bloco de lexemas. Os vetores
+ *  do fluxo crescem dobrando de tamanho.
  *
- * @return unsigned int, linha do ultimo token retornado pelo getToken().
+ * @param signo tCodigoToken : codigo do token.
+ * @param linha unsigned int : linha do token.
+ * @param coluna unsigned int : coluna do token.
+ * @param inicio unsigned int : deslocamento do primeiro caracter do token no fonte.
+ * @return tControle SUCESSO ou ERRO se faltar memoria.
  */
-unsigned int getLinhaAtual(void) {
+tControle anexarToken(tCodigoToken signo, unsigned int linha, unsigned int coluna,
+                      unsigned int inicio) {
 
-      return linhaAtual;
+      auto unsigned int tamanho = posicao - inicio;
+      auto unsigned int capacidade;
+      auto unsigned char *signos;
+      auto unsigned int *numeros;
+
+      if(fluxo.total == fluxo.capacidade) {
+
+             capacidade = fluxo.capacidade ? 2 * fluxo.capacidade : TOKENS_INICIAIS;
+
+             /*cada vetor que cresce ja fica no fluxo; a capacidade so muda com os quatro*/
+             if(!(signos = (unsigned char*) realloc(fluxo.signo, capacidade * sizeof(unsigned char))))
+                    return ERRO;
+             fluxo.signo = signos;
+
+             if(!(numeros = (unsigned int*) realloc(fluxo.linha, capacidade * sizeof(unsigned int))))
+                    return ERRO;
+             fluxo.linha = numeros;
+
+             if(!(numeros = (unsigned int*) realloc(fluxo.coluna, capacidade * sizeof(unsigned int))))
+                    return ERRO;
+             fluxo.coluna = numeros;
+
+             if(!(numeros = (unsigned int*) realloc(fluxo.lexema, capacidade * sizeof(unsigned int))))
+                    return ERRO;
+             fluxo.lexema = numeros;
+
+             fluxo.capacidade = capacidade;
+      }
+
+      fluxo.signo[fluxo.total]   = (unsigned char) signo;
+      fluxo.linha[fluxo.total]   = linha;
+      fluxo.coluna[fluxo.total]  = coluna;
+      fluxo.lexema[fluxo.total]  = tamanhoLexemas;
+      ++fluxo.total;
+
+      /*o bloco de lexemas nunca passa de dois bytes por byte do fonte*/
+      memcpy(lexemas + tamanhoLexemas, fonte + inicio, tamanho);
+      tamanhoLexemas += tamanho;
+      lexemas[tamanhoLexemas++] = '\0';
+
+      return SUCESSO;
 }
 
 /**
- * tControle ignoraComentarios(tToken*);
+ * tControle ignoraComentarios(void);
  *
  * Funcao chamada quando encontrou-se um '{' serve para ignorar tudo ate
  *  encontrar um '}'. Porem considerendo que o '{' ja foi consumido. Fazendo
  *  para tanto a atualizacao das linhas quando necessario.
  *
- * @param saida tToken* : retorna a linha e o codigo caso de erro.
- *
  * @return retorna SUCESSO se ignorou o comentario inteiro e FIM_DE_ARQUIVO
  *  caso tenha atingido o final do arquivo antes de fechar o comentario.
  */
-tControle ignoraComentarios(tToken *saida) {
+tControle ignoraComentarios(void) {
 
       /*automato de comentario segundo estado*/
-      auto char lido;
-
-      /*descobrir inicio do comentario*/
-      saida->signo = COMENTARIO_ERRO;
+      auto char lido = '\0';
 
 	/*consome o '{'*/
-	fread(&lido, sizeof(char), 1, arqOrigem);
+	LER(lido);
 
       /*consome tudo que o programa apresenta ate encontro um '}'*/
-      while(fread(&lido, sizeof(char), 1, arqOrigem) && lido != '}')
+      while(LER(lido) && lido != '}')
              /*verifica se houve mudanca de linha*/
-             if(lido == NOVA_LINHA)
+             if(lido == NOVA_LINHA) {
                     ++linhaAtual;
+                    inicioLinha = posicao;
+             }
 
       return lido == '}' ? SUCESSO : FIM_DE_ARQUIVO;
 }
 
 /**
- * void automatoDigitos(tToken*);
+ * tCodigoToken automatoDigitos(void);
  *
  * Procedimento do automato que reconhece numeros inteiros e reais.
  *
- * @param saida tToken* : retorna o token com o numero.
+ * @return tCodigoToken : NUMERO_INTEIRO ou NUMERO_REAL.
  */
-void automatoDigitos(tToken *saida) {
+tCodigoToken automatoDigitos(void) {
 
-      auto char digito;
-      auto unsigned short i = 0;
+      auto char digito = '\0';
+      auto tCodigoToken signo;
+      auto unsigned int depoisVirgula;
 
       /*q1 - le os digitos da parte inteira*/
-      while(fread(&digito, sizeof(char), 1, arqOrigem) && digito >= '0' && digito <= '9')
-                    saida->cadeia[i++] = digito;
+      while(LER(digito) && digito >= '0' && digito <= '9')
+                    ;
 
       if(digito != ',') /*q numero_inteiro*/
-             saida->signo = NUMERO_INTEIRO;
+             signo = NUMERO_INTEIRO;
       else { /*q2*/
 
-             /*concatena virugla a cadeia*/
-             saida->cadeia[i++] = ',';
+             depoisVirgula = posicao;
 
              /*continua a leitura apos a virgula*/
-             while(fread(&digito, sizeof(char), 1, arqOrigem) &&
-                   digito >= '0' && digito <= '9')
-                    saida->cadeia[i++] = digito;
+             while(LER(digito) && digito >= '0' && digito <= '9')
+                    ;
 
              /*verifica se apos a virgula havia outros numeros*/
-             if(saida->cadeia[--i] == ',') {
+             if(posicao - 1 == depoisVirgula) {
                     /*nao houve outro numero apos a virgula; exemplo: "1,a"*/
                     RETROCEDER()
-                    saida->signo = NUMERO_INTEIRO;
+                    signo = NUMERO_INTEIRO;
              }
-             else {
+             else
                     /*houve numeros apos a virgula; exemplo "2,1"*/
-                    ++i; /*para nao perder digito ao colocar '/0'*/
-                    saida->signo = NUMERO_REAL;
-             }
+                    signo = NUMERO_REAL;
       }
 
-      /*colocando o terminador e acertando cabecote de leitura*/
-      saida->cadeia[i] = '\0'; /*i esta sempre um a frente do indice*/
+      /*acertando cabecote de leitura*/
       RETROCEDER()
+
+      return signo;
 }
 
 /**
- * void automatoMenor(tToken*);
+ * tCodigoToken automatoMenor(void);
  *
  * Reconhece cadeias iniciadas com menor ( <, <=, <>)
  *
- * @param saida : tToken* retorna o token
+ * @return tCodigoToken : codigo do token reconhecido.
  */
-void automatoMenor(tToken *saida) {
+tCodigoToken automatoMenor(void) {
 
-      auto char proximo;
+      auto char proximo = '\0';
+      auto unsigned int inicio = posicao;
 
       /*le o menor*/
-      fread(&saida->cadeia[0], sizeof(char), 1, arqOrigem);
+      ++posicao;
 
       /*lendo o proximo digito, '>' ou '=' ou ?*/
-      fread(&proximo, sizeof(char), 1, arqOrigem);
+      LER(proximo);
 
-      if(proximo == '>' || proximo == '=') {
-             saida->cadeia[1] = proximo;
-             saida->cadeia[2] = '\0';
-      }
-      else {
-             saida->cadeia[1] = '\0';
+      if(proximo != '>' && proximo != '=')
              RETROCEDER()
-      }
 
-      saida->signo = buscarPalavraReservada(saida->cadeia);
+      return buscarPalavraReservada(fonte + inicio, posicao - inicio);
 }
 
 /**
- * void automatoMaior(tToken*);
+ * tCodigoToken automatoMaior(void);
  *
  * Reconhece cadeia comecada com maior: >= ou >
  *
- * @param saida tToken* : retorna o token reconhecido
+ * @return tCodigoToken : codigo do token reconhecido.
  */
-void automatoMaior(tToken *saida) {
+tCodigoToken automatoMaior(void) {
 
-      auto char proximo;
+      auto char proximo = '\0';
+      auto unsigned int inicio = posicao;
 
       /*le o maior*/
-      fread(&saida->cadeia[0], sizeof(char), 1, arqOrigem);
+      ++posicao;
 
       /*lendo o proximo digito, '=' ou ?*/
-      fread(&proximo, sizeof(char), 1, arqOrigem);
+      LER(proximo);
 
-      if(proximo == '=') {
-             saida->cadeia[1] = '=';
-             saida->cadeia[2] = '\0';
-      }
-      else {
-             saida->cadeia[1] = '\0';
+      if(proximo != '=')
              RETROCEDER()
-      }
 
-      saida->signo = buscarPalavraReservada(saida->cadeia);
+      return buscarPalavraReservada(fonte + inicio, posicao - inicio);
 }
 
 /**
- * void automatoDoisPontos(tToken*);
+ * tCodigoToken automatoDoisPontos(void);
  *
  * Reconhece cadeia comecada com dois pontos: := ou :
  *
- * @param saida tToken* : retorna o token reconhecido
+ * @return tCodigoToken : codigo do token reconhecido.
  */
-void automatoDoisPontos(tToken *saida) {
+tCodigoToken automatoDoisPontos(void) {
 
-      auto char proximo;
+      auto char proximo = '\0';
+      auto unsigned int inicio = posicao;
 
-      /*le o maior*/
-      fread(&saida->cadeia[0], sizeof(char), 1, arqOrigem);
+      /*le o dois pontos*/
+      ++posicao;
 
       /*lendo o proximo digito, '=' ou ?*/
-      fread(&proximo, sizeof(char), 1, arqOrigem);
+      LER(proximo);
 
-      if(proximo == '=') {
-             saida->cadeia[1] = '=';
-             saida->cadeia[2] = '\0';
-      }
-      else {
-             saida->cadeia[1] = '\0';
+      if(proximo != '=')
              RETROCEDER()
-      }
 
-      saida->signo = buscarPalavraReservada(saida->cadeia);
+      return buscarPalavraReservada(fonte + inicio, posicao - inicio);
 }
 
 /**
- * void automatoOutros(tToken*);
+ * tCodigoToken automatoOutros(void);
  *
  * Reconhece outros simbulos, simples da linguagem, assim como '(', ')' ...
  *
- * @param saida tToken* : retorna o token reconhecido
+ * @return tCodigoToken : codigo do token reconhecido ou TOKEN_ERRO.
  */
-void automatoOutros(tToken *saida) {
+tCodigoToken automatoOutros(void) {
 
-      /*le um simbulo e coloca o terminador*/
-      fread(&saida->cadeia[0], sizeof(char), 1, arqOrigem);
-      saida->cadeia[1] = '\0';
+      auto tCodigoToken signo;
 
       /*verifica se o simbulo eh reservado, senao erro.*/
-      if(!(saida->signo = buscarPalavraReservada(saida->cadeia)))
-             saida->signo = TOKEN_ERRO;
+      if(!(signo = buscarPalavraReservada(fonte + posicao++, 1)))
+             signo = TOKEN_ERRO;
+
+      return signo;
 }
 
 /**
- * void automatoIdent(tToken*)
+ * tCodigoToken automatoIdent(void)
  *
  * Reconhece identificadore e palavras reservadas.
  *
- * @param saida tToken* : retorna o token reconhecido
+ * @return tCodigoToken : codigo do token reconhecido.
  */
-void automatoIdent(tToken *saida) {
+tCodigoToken automatoIdent(void) {
 
        auto char ehId = 0; /*decidir se consulta tabela reservada*/
-       auto unsigned short int i = 0;
-
-       /*ledo do arquivo a cadeia e testando-a*/
-       while(fread(&saida->cadeia[i], sizeof(char), 1, arqOrigem) &&
-             ((saida->cadeia[i] >= 'a' && saida->cadeia[i] <= 'z') ||
-              (saida->cadeia[i] >= 'A' && saida->cadeia[i] <= 'Z') ||
-              (saida->cadeia[i] >= '0' && saida->cadeia[i] <= '9')))
-              if(saida->cadeia[i++] < 'a' || saida->cadeia[i - 1] > 'z')
+       auto char lido = '\0';
+       auto unsigned int inicio = posicao;
+       auto tCodigoToken signo;
+
+       /*ledo do fonte a cadeia e testando-a*/
+       while(LER(lido) &&
+             ((lido >= 'a' && lido <= 'z') ||
+              (lido >= 'A' && lido <= 'Z') ||
+              (lido >= '0' && lido <= '9')))
+              if(lido < 'a' || lido > 'z')
                      ehId = 1;
 
        /*retrocede o outro*/
        RETROCEDER()
 
-       /*finalizando cadeia*/
-       saida->cadeia[i] = '\0';
-
        /*se a cadeia tiver A-Z ou 0-9 cai direto em identificador*/
        if(ehId)
-              saida->signo = IDENTIFICADOR;
+              signo = IDENTIFICADOR;
        else {
-              saida->signo = buscarPalavraReservada(saida->cadeia);
+              signo = buscarPalavraReservada(fonte + inicio, posicao - inicio);
 
-              if(!saida->signo) /*se cadeina nao eh reservada*/
-                     saida->signo = IDENTIFICADOR;
+              if(!signo) /*se cadeina nao eh reservada*/
+                     signo = IDENTIFICADOR;
        }
+
+       return signo;
 }
 
 /**
- * tControle getToken(tToken*);
+ * tControle analisarFonte(void);
  *
- * Funcao que retorna atravez de seu parametro o token lido e identificado pelo
- *  analizador lexico.
- *
- * @param saida tToken* : tokens lido e identificado
+ * Percorre todo o codigo-fonte em memoria produzindo o fluxo de tokens. Os
+ *  tokens invalidos e o comentario nao fechado tambem entram no fluxo, seus
+ *  erros sao relatados apenas quando o analisador sintatico chega a eles, para
+ *  que as mensagens saiam na ordem do fonte.
  *
- * @return tControle: retorna SUCESSO se o token foi lido e FIM_DE_ARQUIVO caso
- *                     o arquivo tenha terminado
+ * @return tControle : SUCESSO ou ERRO se faltar memoria.
  */
-tControle getToken(tToken *saida) {
+tControle analisarFonte(void) {
 
       auto char lido;
+      auto unsigned int inicio;
+      auto tCodigoToken signo;
 
-      /*ignorando espacos, tabs e novas linhas*/
-      do {
-             if(!fread(&lido, sizeof(char), 1, arqOrigem))
-                    return FIM_DE_ARQUIVO;
-             else
-                    if(lido == NOVA_LINHA)
-                           ++linhaAtual;
-      } while(lido == ' ' || lido == NOVA_LINHA || lido == TAB);
+      /*cada token ocupa ao menos um byte e gasta no maximo mais um com o '\0'*/
+      if(!(lexemas = (char*) malloc(2 * tamanhoFonte + 1)))
+             return ERRO;
 
-      /*retrocedendo para entrar no automado a partir do primeiro simbulo*/
-      RETROCEDER()
+      while(LER(lido)) {
 
-      /*linha do proximo token*/
-      saida->linha = getLinhaAtual();
+             /*ignorando espacos, tabs e novas linhas*/
+             if(lido == ' ' || lido == NOVA_LINHA || lido == TAB) {
+                    if(lido == NOVA_LINHA) {
+                           ++linhaAtual;
+                           inicioLinha = posicao;
+                    }
+                    continue;
+             }
 
-      /*escolhendo automato a partir dos primeiros simbulos*/
-      if(lido == '{') {
-             /*automato que ignora comentarios*/
-             if(ignoraComentarios(saida) == FIM_DE_ARQUIVO)
-                    return SUCESSO;
-             else
-                    return getToken(saida);
-      }
-      else
-             if(lido >= '0' && lido <= '9')
-                    /*automato que reconhece numeros reais e inteiros*/
-                    automatoDigitos(saida);
+             /*retrocedendo para entrar no automado a partir do primeiro simbulo*/
+             RETROCEDER()
+             inicio = posicao;
+
+             /*escolhendo automato a partir dos primeiros simbulos*/
+             if(lido == '{') {
+                    /*automato que ignora comentarios*/
+                    if(ignoraComentarios() == FIM_DE_ARQUIVO) {
+                           /*comentario nao fechado eh o ultimo token do fluxo,
+                            * relatado no final do fonte*/
+                           posicao = inicio;
+                           return anexarToken(COMENTARIO_ERRO, linhaAtual,
+                                              tamanhoFonte - inicioLinha + 1, inicio);
+                    }
+                    continue;
+             }
              else
-                     if(lido == '<')
-                            /*automato que reconhece os menor*/
-                            automatoMenor(saida);
-                     else
-                            if(lido == '>')
-                                   /*automato que reconhece o maior*/
-                                   automatoMaior(saida);
+                    if(lido >= '0' && lido <= '9')
+                           /*automato que reconhece numeros reais e inteiros*/
+                           signo = automatoDigitos();
+                    else
+                            if(lido == '<')
+                                   /*automato que reconhece os menor*/
+                                   signo = automatoMenor();
                             else
-                                   if(lido == ':')
-                                          /*automato que reconhece dois pontos*/
-                                          automatoDoisPontos(saida);
+                                   if(lido == '>')
+                                          /*automato que reconhece o maior*/
+                                          signo = automatoMaior();
                                    else
-                                          if((lido >= 'a' && lido <= 'z') ||
-                                             (lido >= 'A' && lido <= 'Z'))
-                                                 /*automato dos identificadores*/
-                                                 automatoIdent(saida);
+                                          if(lido == ':')
+                                                 /*automato que reconhece dois pontos*/
+                                                 signo = automatoDoisPontos();
                                           else
-                                                 /*automato dos outros simbulos
-                                                  * unicos*/
-                                                 automatoOutros(saida);
+                                                 if((lido >= 'a' && lido <= 'z') ||
+                                                    (lido >= 'A' && lido <= 'Z'))
+                                                        /*automato dos identificadores*/
+                                                        signo = automatoIdent();
+                                                 else
+                                                        /*automato dos outros simbulos
+                                                         * unicos*/
+                                                        signo = automatoOutros();
+
+             /*ao passar do limite de memoria o fluxo termina aqui, o erro eh
+              * relatado pela analise sintatica*/
+             if(!(fluxo.total % TOKENS_POR_CONFERENCIA) && conferirMemoria() != SUCESSO)
+                    return SUCESSO;
+
+             if(anexarToken(signo, linhaAtual, inicio - inicioLinha + 1, inicio) != SUCESSO)
+                    return ERRO;
+      }
+
+      return SUCESSO;
+}
+
+/**
+ * void ajustarLexemas(void);
+ *
+ * O bloco de lexemas eh reservado para o pior caso, dois bytes por byte do
+ *  fonte; ao fim da analise lexica a parte nao usada volta para o sistema.
+ */
+void ajustarLexemas(void) {
+
+      auto char *ajustado;
+
+      if((ajustado = (char*) realloc(lexemas, tamanhoLexemas + 1)))
+             lexemas = ajustado;
+}
+
+/**
+ * void posicionarInicio(void);
+ *
+ * Ao fim da analise lexica a posicao atual volta ao inicio do fonte. Se o
+ *  limite de memoria ja passou ela fica no ultimo token lido, onde a analise
+ *  sintatica relata o erro.
+ */
+void posicionarInicio(void) {
+
+      if(conferirMemoria() != SUCESSO && fluxo.total) {
+             linhaAtual  = fluxo.linha[fluxo.total - 1];
+             colunaAtual = fluxo.coluna[fluxo.total - 1];
+      }
+      else
+             linhaAtual = colunaAtual = 1;
+}
+
+/**
+ * tControle iniciarAnalisadorLexico(const char*);
+ *
+ * Funcao tem por finalidade abrir o arquivo que o analisador lexico utilizara,
+ *  o nome do proposto arquivo eh recebido como parametro. O arquivo eh lido
+ *  para a memoria e fechado, entao todo o fluxo de tokens eh produzido. Se nao
+ *  houve erros eh retornado SUCESSO, caso contrario ERRO_AO_ABRIR_ORIGEM (caso o
+ *  arquivo nao exista ou falhe ao abrir).
+ * O nome "-" indica a entrada padrao, que pode ser um pipe: como o fonte eh
+ *  lido inteiro antes da analise, nenhum retrocesso acontece no arquivo.
+ *
+ * @param nomeArquivo: char* recebe o nome do arquivo origem
+ * @return tControle SUCESSO ou ERRO_AO_ABRI_ORIGEM
+ */
+tControle iniciarAnalisadorLexico(const char *nomeArquivo) {
+
+       auto FILE *arqOrigem;
+       auto tControle controle;
+
+       linhaAtual = colunaAtual = 1;
+       posicao = inicioLinha = cursor = tamanhoLexemas = 0;
+
+       if(!strcmp(nomeArquivo, "-"))
+              arqOrigem = stdin;
+       else if(!(arqOrigem = fopen(nomeArquivo, "rt")))
+              return ERRO_AO_ABRIR_ORIGEM;
+
+       controle = carregarFonte(arqOrigem);
+       if(arqOrigem != stdin)
+              fclose(arqOrigem);
+
+       if(controle == SUCESSO)
+              controle = analisarFonte();
 
-      /*relata erros lexico e passa o prximo token*/
+       /*as cadeias dos tokens ja estao no bloco de lexemas*/
+       free((char*) fonte);
+       fonte = NULL;
+
+       if(controle != SUCESSO)
+              return ERRO_AO_ABRIR_ORIGEM;
+
+       ajustarLexemas();
+       posicionarInicio();
+       return SUCESSO;
+}
+
+/**
+ * tControle iniciarAnalisadorLexicoMemoria(const char*, size_t);
+ *
+ * Equivalente ao iniciarAnalisadorLexico, porem o codigo-fonte vem de um bloco
+ *  de memoria em vez de um arquivo. O bloco eh lido diretamente, sem copia,
+ *  e nao eh mais usado depois que a funcao retorna.
+ *
+ * @param codigo const char* : codigo-fonte, nao precisa terminar em '\0'.
+ * @param tamanho size_t : numero de bytes do codigo-fonte.
+ * @return tControle SUCESSO ou ERRO_AO_ABRIR_ORIGEM se faltar memoria.
+ */
+tControle iniciarAnalisadorLexicoMemoria(const char *codigo, size_t tamanho) {
+
+       auto tControle controle;
+
+       linhaAtual = colunaAtual = 1;
+       posicao = inicioLinha = cursor = tamanhoLexemas = 0;
+
+       if(tamanho >= (unsigned int) -1 / 2)
+              return ERRO_AO_ABRIR_ORIGEM;
+
+       fonte = codigo;
+       tamanhoFonte = (unsigned int) tamanho;
+
+       controle = analisarFonte();
+       fonte = NULL;
+
+       if(controle != SUCESSO)
+              return ERRO_AO_ABRIR_ORIGEM;
+
+       ajustarLexemas();
+       posicionarInicio();
+       return SUCESSO;
+}
+
+/**
+ * void fecharAnalisadorLexico(void);
+ *
+ * Funcao tem por finalidade liberar o fluxo de tokens que o analisador lexico
+ *  utilizou. O fonte ja foi liberado ao fim da analise lexica.
+ */
+void fecharAnalisadorLexico(void) {
+
+      free(lexemas);
+      free(fluxo.signo);
+      free(fluxo.linha);
+      free(fluxo.coluna);
+      free(fluxo.lexema);
+
+      lexemas = NULL;
+      memset(&fluxo, 0, sizeof(tFluxoTokens));
+}
+
+/**
+ * unsigned int getLinhaAtual(void);
+ *
+ * Funcao retorna o numero da linha que se encontra o token atual.
+ *
+ * @return unsigned int, linha do ultimo token retornado pelo getToken().
+ */
+unsigned int getLinhaAtual(void) {
+
+      return linhaAtual;
+}
+
+/**
+ * unsigned int getColunaAtual(void);
+ *
+ * Funcao retorna o numero da coluna em que comeca o token atual.
+ *
+ * @return unsigned int, coluna do ultimo token retornado pelo getToken().
+ */
+unsigned int getColunaAtual(void) {
+
+      return colunaAtual;
+}
+
+/**
+ * unsigned int getIndiceToken(void);
+ *
+ * Funcao retorna a posicao no fluxo do proximo token a ser entregue, o token
+ *  atual esta na posicao anterior.
+ *
+ * @return unsigned int, indice do proximo token.
+ */
+unsigned int getIndiceToken(void) {
+
+      return cursor;
+}
+
+/**
+ * void irParaToken(unsigned int);
+ *
+ * Reposiciona o fluxo sem entregar tokens ao sintatico, usado para pular ou
+ *  revisitar um trecho. O proximo getToken() entrega o token indicado.
+ *
+ * @param indice unsigned int : posicao do proximo token a ser entregue.
+ */
+void irParaToken(unsigned int indice) {
+
+      cursor = indice < fluxo.total ? indice : fluxo.total;
+}
+
+/**
+ * tCodigoToken signoToken(unsigned int);
+ *
+ * Funcao retorna o codigo de um token qualquer do fluxo, sem entrega-lo.
+ *
+ * @param indice unsigned int : posicao do token no fluxo.
+ * @return tCodigoToken, codigo do token ou zero se nao existir.
+ */
+tCodigoToken signoToken(unsigned int indice) {
+
+      return indice < fluxo.total ? fluxo.signo[indice] : 0;
+}
+
+/**
+ * const char* lexemaToken(unsigned int);
+ *
+ * Funcao retorna a cadeia de um token qualquer do fluxo, sem entrega-lo.
+ *
+ * @param indice unsigned int : posicao do token no fluxo.
+ * @return const char*, cadeia do token ou NULL se nao existir.
+ */
+const char *lexemaToken(unsigned int indice) {
+
+      return indice < fluxo.total ? lexemas + fluxo.lexema[indice] : NULL;
+}
+
+/**
+ * tChave impressaoTokens(unsigned int, unsigned int);
+ *
+ * Calcula a impressao digital (FNV-1a de 64 bits) de um trecho do fluxo, sobre
+ *  os codigos dos tokens e seus caracteres no fonte. O fonte ja foi liberado,
+ *  entao os caracteres vem do bloco de lexemas, que guarda os lexemas como
+ *  estao no fonte. Linhas e colunas so entram quando o codigo gerado cita as
+ *  posicoes do fonte; fora isso mover um trecho sem altera-lo mantem sua
+ *  impressao.
+ *
+ * @param inicio unsigned int : posicao do primeiro token.
+ * @param total unsigned int : numero de tokens.
+ * @return tChave, impressao do trecho ou zero se ele passa do fim do fluxo.
+ */
+tChave impressaoTokens(unsigned int inicio, unsigned int total) {
+
+      auto tChave impressao = ESPALHAMENTO_BASE;
+      register const char *c;
+      register unsigned int i;
+
+      if (inicio > fluxo.total || total > fluxo.total - inicio)
+             return 0;
+
+      for (i = inicio; i < inicio + total; ++i) {
+
+             impressao = (impressao ^ fluxo.signo[i]) * ESPALHAMENTO_PRIMO;
+
+             for (c = lexemas + fluxo.lexema[i]; *c; ++c)
+                    impressao = ESPALHAR(impressao, *c);
+             impressao *= ESPALHAMENTO_PRIMO;
+
+             if(posicoesNaImpressao)
+                    impressao = ((impressao ^ fluxo.linha[i]) * ESPALHAMENTO_PRIMO ^ fluxo.coluna[i])
+                                  * ESPALHAMENTO_PRIMO;
+      }
+
+      return impressao;
+}
+
+/**
+ * void incluirPosicoesNaImpressao(signed char);
+ *
+ * Faz as impressoes digitais dos trechos dependerem tambem das linhas e colunas
+ *  dos tokens, para quando o codigo gerado cita as posicoes do fonte.
+ *
+ * @param incluir signed char : diferente de zero para incluir as posicoes.
+ */
+void incluirPosicoesNaImpressao(signed char incluir) {
+
+      posicoesNaImpressao = incluir;
+}
+
+/**
+ * tControle getToken(tToken*);
+ *
+ * Funcao que retorna atravez de seu parametro o proximo token do fluxo produzido
+ *  pelo analizador lexico. A cadeia do token aponta para o bloco de lexemas.
+ *
+ * @param saida tToken* : tokens lido e identificado
+ *
+ * Quando o limite de erros eh atingido o fluxo eh dado como terminado, assim
+ *  a analise se encerra pelo mesmo caminho do final de arquivo.
+ *
+ * @return tControle: retorna SUCESSO se o token foi lido e FIM_DE_ARQUIVO caso
+ *                     o arquivo tenha terminado
+ */
+tControle getToken(tToken *saida) {
+
+      MEDIR_INICIO(SUBSISTEMA_LEXICO);
+
+      if(cursor >= fluxo.total || limiteDeErrosAtingido())
+             return MEDIR_FIM_VALOR(FIM_DE_ARQUIVO);
+
+      saida->signo  = fluxo.signo[cursor];
+      saida->linha  = linhaAtual = fluxo.linha[cursor];
+      colunaAtual   = fluxo.coluna[cursor];
+      saida->cadeia = lexemas + fluxo.lexema[cursor];
+      ++cursor;
+
+      /*relata erros lexico e passa o proximo token*/
       if (saida->signo == TOKEN_ERRO) {
     	  mensagemErro("Token invalido.");
-    	  return getToken(saida);
+    	  return MEDIR_FIM_VALOR(getToken(saida));
       }
 
-      return SUCESSO;
+      return MEDIR_FIM_VALOR(SUCESSO);
 }
 
 #endif
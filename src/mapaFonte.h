@@ -0,0 +1,151 @@
+/**
+ * mapaFonte.h
+ *
+ * Mapa do codigo gerado para o fonte em ALG.
+ *
+ * Com o mapa ligado o gerador escreve, antes de cada comando, uma diretiva #line
+ *  com a linha do comando, sua coluna em um comentario e o nome do fonte, assim
+ *  o compilador C e as ferramentas que leem a depuracao (gdb, perf) atribuem o
+ *  codigo gerado as linhas do programa em ALG.
+ * Terminada a traducao, o arquivo gerado eh percorrido e as diretivas viram um
+ *  mapa em JSON, gravado ao lado dele com a extensao ".map.json", que leva o
+ *  deslocamento e a linha de cada trecho do codigo gerado a linha e a coluna do
+ *  fonte. Como o mapa vem do arquivo pronto, os trechos compilados em outros
+ *  processos ou copiados do cache entram nele sem tratamento especial; para o
+ *  cache nao devolver posicoes antigas, as impressoes digitais dos trechos
+ *  passam a depender das linhas e colunas dos tokens.
+ *
+ * @see geradorCodigo
+ * @see incremental
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _MAPAFONTE_H_
+#define _MAPAFONTE_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "diagnosticos.h"
+
+/*defines*/
+#define EXTENSAO_MAPA ".map.json" /*acrescentada ao nome do arquivo gerado*/
+
+/*trazendo funcao de outro modulo*/
+extern void incluirPosicoesNaImpressao(signed char);
+
+/*variaveis globais*/
+static const char *fonteMapa; /**fonte citado nas diretivas, NULL com o mapa desligado*/
+
+/*funcoes e procedimentos*/
+/**
+ * Liga o mapa do codigo gerado.
+ *
+ * @param nomeFonte const char* : nome do arquivo fonte, citado nas diretivas.
+ */
+void iniciarMapa(const char *nomeFonte) {
+
+	fonteMapa = nomeFonte;
+	incluirPosicoesNaImpressao(1);
+}
+
+/**
+ * Escreve uma diretiva #line
+ *
+ * A diretiva ocupa uma linha propria e vale para a linha seguinte do arquivo,
+ *  onde comeca o comando.
+ *
+ * @param saida FILE* : arquivo gerado.
+ * @param linha unsigned int : linha do comando no fonte.
+ * @param coluna unsigned int : coluna do comando no fonte.
+ */
+void escreverDiretivaLinha(FILE *saida, unsigned int linha, unsigned int coluna) {
+
+	register const char *c;
+
+	fprintf(saida, "\n#line %u /* coluna %u */ \"", linha, coluna);
+
+	for (c = fonteMapa; *c; ++c) {
+		if (*c == '"' || *c == '\\')
+			fputc('\\', saida);
+		fputc(*c, saida);
+	}
+
+	fputc('"', saida);
+}
+
+/**
+ * Grava o mapa
+ *
+ * Percorre o arquivo gerado e escreve, para cada diretiva #line, o deslocamento
+ *  e o numero da linha seguinte do arquivo gerado com a linha e a coluna do
+ *  fonte. Cada trecho vai ate o inicio do trecho seguinte.
+ *
+ * @param nomeGerado const char* : nome do arquivo gerado, ja fechado, ou vazio.
+ * @return SUCESSO, ou ERRO se algum arquivo nao pode ser aberto.
+ */
+tControle gravarMapa(const char *nomeGerado) {
+
+	auto FILE *gerado, *mapa;
+	auto char *nomeMapa;
+	auto unsigned long linhaGerada;
+	auto unsigned int linha, coluna, total = 0;
+	auto signed char diretiva;
+	register int c;
+
+	/*sem arquivo com nome (saida padrao ou memoria) nao ha o que reler*/
+	if (!fonteMapa || !*nomeGerado)
+		return SUCESSO;
+
+	if (!(nomeMapa = (char*) malloc(strlen(nomeGerado) + sizeof(EXTENSAO_MAPA))))
+		return ERRO;
+	strcat(strcpy(nomeMapa, nomeGerado), EXTENSAO_MAPA);
+
+	gerado = fopen(nomeGerado, "rb");
+	mapa = gerado ? fopen(nomeMapa, "wt") : NULL;
+	free(nomeMapa);
+
+	if (!mapa) {
+		if (gerado)
+			fclose(gerado);
+		return ERRO;
+	}
+
+	fprintf(mapa, "{\"fonte\": ");
+	escreverCadeiaJson(mapa, fonteMapa);
+	fprintf(mapa, ", \"gerado\": ");
+	escreverCadeiaJson(mapa, nomeGerado);
+	fprintf(mapa, ", \"trechos\": [");
+
+	/*uma volta por linha do arquivo gerado*/
+	for (linhaGerada = 1; ; ++linhaGerada) {
+
+		diretiva = fscanf(gerado, "#line %u /* coluna %u */", &linha, &coluna) == 2;
+
+		/*pulando o resto da linha*/
+		while ((c = fgetc(gerado)) != EOF && c != '\n')
+			;
+
+		if (c == EOF)
+			break;
+
+		if (diretiva)
+			fprintf(mapa, "%s\n  {\"deslocamento\": %ld, \"linhaGerada\": %lu, \"linha\": %u, \"coluna\": %u}",
+					total++ ? "," : "", ftell(gerado), linhaGerada + 1, linha, coluna);
+	}
+
+	fclose(gerado);
+
+	fprintf(mapa, "%s]}\n", total ? "\n" : "");
+	fclose(mapa);
+
+	return SUCESSO;
+}
+
+#endif /* _MAPAFONTE_H_ */
@@ -0,0 +1,98 @@
+/**
+ * memoria.h
+ *
+ * Limite de memoria da compilacao.
+ *
+ * Com um limite definido o pico de memoria residente do processo, medido por
+ *  getrusage, eh conferido quando o fluxo de tokens cresce e ao fim de cada
+ *  procedimento. Ao passar do limite a analise lexica para e a analise
+ *  sintatica relata o erro e termina como se o limite de erros tivesse sido
+ *  atingido, em vez de o compilador seguir ate esgotar a memoria da maquina.
+ *  Sem limite nada eh medido.
+ *
+ * @see lexico
+ * @see sintatico
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _MEMORIA_H_
+#define _MEMORIA_H_
+
+/*includes*/
+#include <sys/time.h>
+#include <sys/resource.h>
+#include "padroes.h"
+
+/*variaveis globais*/
+static unsigned long limiteMemoria; /**limite em kilobytes, zero para nao haver limite*/
+static signed char memoriaExcedida; /**diferente de zero depois de passar do limite*/
+
+/*funcoes e procedimentos*/
+/**
+ * Define o limite de memoria.
+ *
+ * @param megabytes unsigned long : pico de memoria residente permitido, zero
+ *         para nao haver limite.
+ */
+void iniciarLimiteMemoria(unsigned long megabytes) {
+
+	limiteMemoria = megabytes * 1024;
+	memoriaExcedida = 0;
+}
+
+/**
+ * Pico de memoria residente do processo ate agora.
+ *
+ * @return unsigned long : pico em kilobytes, zero se nao puder ser medido.
+ */
+unsigned long picoMemoria(void) {
+
+	auto struct rusage uso;
+
+	if (getrusage(RUSAGE_SELF, &uso))
+		return 0;
+
+	/*o Linux relata ru_maxrss em kilobytes*/
+	return (unsigned long) uso.ru_maxrss;
+}
+
+/**
+ * Pico de memoria residente em megabytes, arredondado para cima.
+ *
+ * Assim um pico que passou do limite nunca aparece igual a ele.
+ *
+ * @return unsigned long : pico em megabytes, zero se nao puder ser medido.
+ */
+unsigned long picoMemoriaMegabytes(void) {
+
+	return (picoMemoria() + 1023) / 1024;
+}
+
+/**
+ * Confere o limite de memoria.
+ *
+ * @return SUCESSO, ou ERRO se o pico ja passou do limite.
+ */
+tControle conferirMemoria(void) {
+
+	if (limiteMemoria && !memoriaExcedida && picoMemoria() > limiteMemoria)
+		memoriaExcedida = 1;
+
+	return memoriaExcedida ? ERRO : SUCESSO;
+}
+
+/**
+ * Verifica se a compilacao passou do limite de memoria.
+ *
+ * @return diferente de zero se o limite foi ultrapassado.
+ */
+int limiteDeMemoriaAtingido(void) {
+
+	return memoriaExcedida;
+}
+
+#endif /* _MEMORIA_H_ */
@@ -0,0 +1,168 @@
+/**
+ * Tabela de nomes dos identificadores.
+ *
+ * Os registros das tabelas de simbolos (tDados) nao carregam o nome: cada nome
+ *  distinto eh guardado uma unica vez em blocos de caracteres que nunca mudam
+ *  de lugar, e o registro leva apenas o endereco. Assim os nos da arvore e da
+ *  pilha ficam pequenos, a busca le apenas a chave e os campos ao lado dela, e
+ *  o texto do nome so eh visitado para confirmar chaves iguais. Como nomes
+ *  iguais tem o mesmo endereco, essa confirmacao quase sempre se resume a
+ *  comparar dois ponteiros.
+ * Apenas os nomes do escopo global passam por esta tabela. Os nomes locais
+ *  apontam para o bloco de lexemas e somem com o escopo do procedimento, entao
+ *  a tabela cresce com os globais e nao com o tamanho do programa.
+ * Os nomes sao encontrados por um indice de espalhamento (espalhamento), como
+ *  as assinaturas, e duram ate o fim da analise semantica.
+ *
+ * @see semantico
+ * @see assinaturas
+ * @see espalhamento
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _NOMES_H_
+#define _NOMES_H_
+
+/*includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "espalhamento.h"
+
+/*defines*/
+#define NOMES_INICIAIS 256 /*capacidade inicial do indice, potencia de dois*/
+#define BLOCO_NOMES 4096 /*bytes de cada bloco de nomes, nomes maiores tem bloco proprio*/
+
+/*novos tipos*/
+/**
+ * @brief Cabecalho de um bloco de nomes, seguido pelos caracteres.
+ */
+typedef struct sBlocoNomes {
+	struct sBlocoNomes *anterior; /**bloco alocado antes deste*/
+} tBlocoNomes;
+
+/*variaveis globais*/
+static tBlocoNomes *blocosNomes; /**ultimo bloco alocado*/
+static char *livreNomes; /**primeiro byte livre do ultimo bloco*/
+static size_t restanteNomes; /**bytes livres no ultimo bloco*/
+static const char **listaNomes; /**endereco de cada nome, na ordem em que foi guardado*/
+static unsigned int totalNomes; /**numero de nomes guardados*/
+static unsigned int capacidadeListaNomes; /**enderecos alocados*/
+static tIndice indiceNomes; /**indice dos nomes, com o dobro de posicoes que nomes*/
+
+/*funcoes e procedimentos*/
+/**
+ * Espalhamento de um nome guardado. Funcao para uso interno.
+ *
+ * @param numero unsigned int : ordem do nome na lista.
+ * @return tChave : valor de espalhamento.
+ */
+static tChave _espalharNome(unsigned int numero) {
+
+	return espalharCadeia(listaNomes[numero]);
+}
+
+/**
+ * Procura a posicao de um nome na tabela. Funcao para uso interno.
+ *
+ * @param nome const char* : nome procurado.
+ * @return posicao do nome ou da primeira posicao vazia encontrada.
+ */
+static unsigned int _posicaoNome(const char *nome) {
+
+	register unsigned int i = POSICAO_INDICE(&indiceNomes, espalharCadeia(nome));
+
+	while (indiceNomes.item[i] && strcmp(listaNomes[indiceNomes.item[i] - 1], nome))
+		i = PROXIMA_POSICAO(&indiceNomes, i);
+
+	return i;
+}
+
+/**
+ * Guarda um nome
+ *
+ * Se o nome ja foi guardado devolve o mesmo endereco.
+ *
+ * @param nome const char* : nome terminado em '\0'.
+ * @return const char* : copia do nome, que dura ate destruirNomes, ou NULL se
+ *          faltar memoria.
+ */
+const char *internarNome(const char *nome) {
+
+	auto unsigned int posicao;
+	auto size_t tamanho;
+	auto tBlocoNomes *bloco;
+	auto char *copia;
+	auto const char **lista;
+
+	if (2 * (totalNomes + 1) > indiceNomes.capacidade
+			&& crescerIndice(&indiceNomes, NOMES_INICIAIS, totalNomes, _espalharNome) != SUCESSO)
+		return NULL;
+
+	posicao = _posicaoNome(nome);
+	if (indiceNomes.item[posicao])
+		return listaNomes[indiceNomes.item[posicao] - 1];
+
+	if (totalNomes == capacidadeListaNomes) {
+
+		if (!(lista = (const char**) crescerVetor(listaNomes, &capacidadeListaNomes, totalNomes + 1,
+				NOMES_INICIAIS / 2, sizeof(const char*))))
+			return NULL;
+		listaNomes = lista;
+	}
+
+	tamanho = strlen(nome) + 1;
+	if (tamanho > restanteNomes) {
+
+		if (!(bloco = (tBlocoNomes*) malloc(sizeof(tBlocoNomes)
+				+ (tamanho > BLOCO_NOMES ? tamanho : BLOCO_NOMES))))
+			return NULL;
+
+		bloco->anterior = blocosNomes;
+		blocosNomes = bloco;
+		livreNomes = (char*) (bloco + 1);
+		restanteNomes = tamanho > BLOCO_NOMES ? tamanho : BLOCO_NOMES;
+	}
+
+	copia = livreNomes;
+	memcpy(copia, nome, tamanho);
+	livreNomes += tamanho;
+	restanteNomes -= tamanho;
+
+	listaNomes[totalNomes] = copia;
+	indiceNomes.item[posicao] = ++totalNomes;
+
+	return copia;
+}
+
+/**
+ * Destroi a tabela de nomes
+ *
+ * Desaloca o indice, a lista e os blocos; os enderecos devolvidos por internarNome
+ *  deixam de valer.
+ */
+void destruirNomes(void) {
+
+	auto tBlocoNomes *condenado;
+
+	while (blocosNomes) {
+		condenado = blocosNomes;
+		blocosNomes = condenado->anterior;
+		free(condenado);
+	}
+
+	free((void*) listaNomes);
+	destruirIndice(&indiceNomes);
+
+	listaNomes = NULL;
+	livreNomes = NULL;
+	restanteNomes = 0;
+	totalNomes = capacidadeListaNomes = 0;
+}
+
+#endif /* _NOMES_H_ */
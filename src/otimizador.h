@@ -0,0 +1,485 @@
+/**
+ * otimizador.h
+ *
+ * Numeracao de valores local sobre as expressoes.
+ *
+ * Cada valor calculado recebe um numero: variaveis pelo valor que guardam,
+ *  numeros pelo lexema e operacoes pelo operador e pelos numeros dos operandos.
+ *  Duas expressoes com o mesmo numero tem o mesmo valor, assim uma operacao
+ *  cujo valor ja esta guardado em uma variavel eh trocada por essa variavel
+ *  (eliminacao de subexpressoes comuns) e uma variavel que recebeu a copia de
+ *  outra eh trocada pela original (propagacao de copias).
+ * Os numeros valem dentro de um trecho sem desvios. No se, os dois ramos partem
+ *  do estado anterior a condicao e, ao final, so continuam valendo as variaveis
+ *  que nenhum ramo alterou. No enquanto, o corpo pode ser executado varias
+ *  vezes, entao o estado eh descartado antes da condicao e depois do corpo. As
+ *  chamadas de procedimento podem alterar qualquer global e tambem descartam o
+ *  estado.
+ *
+ * @see sintatico
+ * @see expressao
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _OTIMIZADOR_H_
+#define _OTIMIZADOR_H_
+
+/*includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "expressao.h"
+#include "pilhaHash.h"
+#include "fila.h"
+
+/*defines*/
+#define MAX_VALORES 64 /*variaveis e expressoes acompanhadas em cada tabela*/
+
+/*trazendo funcao de outro modulo*/
+extern tFila temporaria;
+
+/*novos tipos*/
+/**
+ * @brief Variavel acompanhada e o numero do valor que ela guarda.
+ */
+typedef struct {
+	char *nome; /**nome da variavel, no bloco de lexemas*/
+	signed char tipo; /**INTEIRO ou REAL*/
+	unsigned int valor; /**numero do valor guardado*/
+	unsigned long desde; /**quando passou a guardar o valor, a mais antiga eh a original*/
+} tValorVariavel;
+
+/**
+ * @brief Expressao numerada: um numero ou uma operacao sobre numeros de valores.
+ */
+typedef struct {
+	tCodigoToken operador; /**codigo do token do no*/
+	signed char tipo; /**INTEIRO ou REAL*/
+	unsigned int esquerda; /**numero do operando esquerdo, zero nos numeros*/
+	unsigned int direita; /**numero do operando direito, zero nos numeros e operacoes unarias*/
+	const char *cadeia; /**lexema dos numeros, NULL nas operacoes*/
+	unsigned int valor; /**numero do valor*/
+} tValorExpressao;
+
+/**
+ * @brief Operando ja numerado, passado de um no do ramo esquerdo ao seu pai.
+ */
+typedef struct {
+	unsigned int valor; /**numero do valor, zero se desconhecido*/
+	signed char trocado; /**diferente de zero se a operacao foi trocada por uma variavel*/
+} tValorOperando;
+
+/**
+ * @brief Estado da numeracao em um ponto do programa.
+ */
+typedef struct {
+	tValorVariavel variaveis[MAX_VALORES]; /**variaveis acompanhadas*/
+	unsigned int totalVariaveis; /**numero de variaveis*/
+	tValorExpressao expressoes[MAX_VALORES]; /**expressoes numeradas*/
+	unsigned int totalExpressoes; /**numero de expressoes*/
+} tEstadoValores;
+
+/*variaveis globais*/
+static signed char otimizacaoAtiva = 1; /**diferente de zero se a numeracao de valores esta ligada*/
+static tEstadoValores estadoValores; /**estado no ponto atual da traducao*/
+static signed char apenasNumerar; /**diferente de zero para numerar sem trocar nenhum no*/
+static unsigned int proximoValor; /**ultimo numero de valor usado, zero eh valor desconhecido*/
+static unsigned long relogioValores; /**conta as atribuicoes, para ordenar as copias*/
+
+/*funcoes e procedimentos*/
+/**
+ * Liga ou desliga a numeracao de valores.
+ *
+ * @param ativa signed char : diferente de zero para ligar.
+ */
+void iniciarOtimizador(signed char ativa) {
+
+	otimizacaoAtiva = ativa;
+}
+
+/**
+ * Descarta o estado
+ *
+ * Chamado no inicio de cada funcao C, antes e depois dos lacos e nas chamadas
+ *  de procedimento. Os numeros nunca se repetem, entao estados salvos antes
+ *  continuam validos.
+ */
+void otmReiniciar(void) {
+
+	estadoValores.totalVariaveis = 0;
+	estadoValores.totalExpressoes = 0;
+}
+
+/**
+ * Procura uma variavel ja acompanhada. Funcao para uso interno.
+ *
+ * @param nome const char* : nome da variavel.
+ * @return a variavel ou NULL se ela nao eh acompanhada.
+ */
+static tValorVariavel *_otmBuscar(const char *nome) {
+
+	register tValorVariavel *variavel = estadoValores.variaveis;
+	register tValorVariavel *fim = variavel + estadoValores.totalVariaveis;
+
+	for (; variavel < fim; ++variavel)
+		if (!strcmp(variavel->nome, nome))
+			return variavel;
+
+	return NULL;
+}
+
+/**
+ * Procura uma variavel, acompanhando-a com um valor novo se ainda nao estava.
+ *  Funcao para uso interno.
+ *
+ * @param nome char* : nome da variavel, deve durar toda a compilacao.
+ * @param tipo signed char : tipo da variavel.
+ * @return a variavel ou NULL se a tabela estiver cheia.
+ */
+static tValorVariavel *_otmVariavel(char *nome, signed char tipo) {
+
+	register tValorVariavel *variavel = _otmBuscar(nome);
+
+	if (variavel)
+		return variavel;
+
+	if (estadoValores.totalVariaveis == MAX_VALORES)
+		return NULL;
+
+	variavel = estadoValores.variaveis + estadoValores.totalVariaveis++;
+	variavel->nome = nome;
+	variavel->tipo = tipo;
+	variavel->valor = ++proximoValor;
+	variavel->desde = ++relogioValores;
+
+	return variavel;
+}
+
+/**
+ * Variavel original de um valor: a que guarda o valor ha mais tempo. Funcao
+ *  para uso interno.
+ *
+ * @param valor unsigned int : numero do valor.
+ * @param tipo signed char : tipo exigido da variavel.
+ * @return a variavel ou NULL se nenhuma guarda o valor.
+ */
+static tValorVariavel *_otmOriginal(unsigned int valor, signed char tipo) {
+
+	register tValorVariavel *variavel = estadoValores.variaveis;
+	register tValorVariavel *fim = variavel + estadoValores.totalVariaveis;
+	auto tValorVariavel *original = NULL;
+
+	for (; variavel < fim; ++variavel)
+		if (variavel->valor == valor && variavel->tipo == tipo
+				&& (!original || variavel->desde < original->desde))
+			original = variavel;
+
+	return original;
+}
+
+/**
+ * Numero de uma expressao, criando um novo se ela ainda nao foi vista. Funcao
+ *  para uso interno.
+ *
+ * @param modelo tValorExpressao* : expressao procurada, sem o valor.
+ * @return numero do valor.
+ */
+static unsigned int _otmNumerar(tValorExpressao *modelo) {
+
+	register tValorExpressao *expressao = estadoValores.expressoes;
+	register tValorExpressao *fim = expressao + estadoValores.totalExpressoes;
+
+	for (; expressao < fim; ++expressao)
+		if (expressao->operador == modelo->operador && expressao->tipo == modelo->tipo
+				&& expressao->esquerda == modelo->esquerda && expressao->direita == modelo->direita
+				&& (!modelo->cadeia || !strcmp(expressao->cadeia, modelo->cadeia)))
+			return expressao->valor;
+
+	modelo->valor = ++proximoValor;
+
+	if (estadoValores.totalExpressoes < MAX_VALORES)
+		estadoValores.expressoes[estadoValores.totalExpressoes++] = *modelo;
+
+	return modelo->valor;
+}
+
+/**
+ * Troca um no pela variavel que guarda o seu valor. Funcao para uso interno.
+ *
+ * @param no tExpressao : no trocado, mantem o tipo.
+ * @param variavel tValorVariavel* : variavel que guarda o valor.
+ */
+static void _otmTrocar(tExpressao no, tValorVariavel *variavel) {
+
+	destruirExpressao(&no->esquerda);
+	destruirExpressao(&no->direita);
+
+	no->operador = IDENTIFICADOR;
+	no->cadeia = variavel->nome;
+}
+
+unsigned int otmExpressao(tExpressao);
+
+/**
+ * Numera um no do ramo esquerdo, cujo operando esquerdo ja foi numerado. Funcao
+ *  para uso interno.
+ *
+ * @param expressao tExpressao : no numerado.
+ * @param pai tExpressao : pai do no, nao usado.
+ * @param contexto void* : tValorOperando com o operando esquerdo, recebe o no.
+ */
+static void _otmNumerarNo(tExpressao expressao, tExpressao pai, void *contexto) {
+
+	auto tValorOperando *operando = (tValorOperando*) contexto;
+	auto tValorExpressao modelo;
+	auto tValorVariavel *variavel;
+	auto unsigned int valor;
+
+	switch (expressao->operador) {
+
+	case IDENTIFICADOR:
+		operando->trocado = 0;
+		if (!(variavel = _otmVariavel(expressao->cadeia, expressao->tipo))) {
+			operando->valor = 0;
+			return;
+		}
+
+		/*propagacao de copias*/
+		if ((variavel = _otmOriginal(variavel->valor, expressao->tipo)) && !apenasNumerar)
+			expressao->cadeia = variavel->nome;
+		operando->valor = variavel ? variavel->valor : 0;
+		return;
+
+	case NUMERO_INTEIRO:
+	case NUMERO_REAL:
+		modelo.operador = expressao->operador;
+		modelo.tipo = expressao->tipo;
+		modelo.esquerda = modelo.direita = 0;
+		modelo.cadeia = expressao->cadeia;
+		operando->valor = _otmNumerar(&modelo);
+		operando->trocado = 0;
+		return;
+
+	case ABRE_PARENTESES:
+		/*agrupamento de uma operacao trocada por variavel vira a variavel*/
+		if (operando->trocado && (variavel = _otmOriginal(operando->valor, expressao->tipo)))
+			_otmTrocar(expressao, variavel);
+		else
+			operando->trocado = 0;
+		return;
+
+	default:
+		modelo.operador = expressao->operador;
+		modelo.tipo = expressao->tipo;
+		modelo.esquerda = operando->valor;
+		modelo.direita = otmExpressao(expressao->direita);
+		modelo.cadeia = NULL;
+
+		operando->valor = operando->trocado = 0;
+
+		if (!modelo.esquerda || (expressao->direita && !modelo.direita))
+			return;
+
+		/*soma e produto nao dependem da ordem dos operandos*/
+		if ((modelo.operador == MAIS || modelo.operador == ASTERISCO) && expressao->direita
+				&& modelo.esquerda > modelo.direita) {
+			valor = modelo.esquerda;
+			modelo.esquerda = modelo.direita;
+			modelo.direita = valor;
+		}
+
+		/*eliminacao de subexpressoes comuns*/
+		operando->valor = _otmNumerar(&modelo);
+		if (!apenasNumerar && (variavel = _otmOriginal(operando->valor, expressao->tipo))) {
+			_otmTrocar(expressao, variavel);
+			operando->trocado = 1;
+		}
+	}
+}
+
+/**
+ * Numera uma expressao tipada
+ *
+ * Percorre a arvore de baixo para cima numerando os nos, troca as variaveis
+ *  copiadas pelas originais e as operacoes ja calculadas pelas variaveis que
+ *  guardam o seu valor. Os tipos dos nos sao mantidos, assim as conversoes
+ *  geradas continuam as mesmas. O ramo esquerdo eh percorrido em laco por
+ *  percorrerExpressao.
+ *
+ * @param expressao tExpressao : expressao ja tipada, pode ser nula.
+ * @return unsigned int : numero do valor da expressao, zero se desconhecido.
+ */
+unsigned int otmExpressao(tExpressao expressao) {
+
+	auto tValorOperando operando;
+
+	if (!otimizacaoAtiva)
+		return 0;
+
+	operando.valor = 0;
+	operando.trocado = 0;
+
+	percorrerExpressao(expressao, NULL, _otmNumerarNo, &operando);
+
+	return operando.valor;
+}
+
+/**
+ * Numera as expressoes de uma condicao
+ *
+ * Como otmExpressao nas duas expressoes, mas se elas tem o mesmo valor nada eh
+ *  trocado: as trocas escreveriam os dois lados iguais, como em d > d, que o
+ *  compilador C avisa como comparacao tautologica.
+ *
+ * @param esquerda tExpressao : expressao a esquerda da relacao, ja tipada.
+ * @param direita tExpressao : expressao a direita da relacao, ja tipada.
+ */
+void otmCondicao(tExpressao esquerda, tExpressao direita) {
+
+	auto unsigned int valor;
+	auto signed char iguais;
+
+	apenasNumerar = 1;
+	iguais = (valor = otmExpressao(esquerda)) && valor == otmExpressao(direita);
+	apenasNumerar = 0;
+
+	if (!iguais) {
+		otmExpressao(esquerda);
+		otmExpressao(direita);
+	}
+}
+
+/**
+ * Registra uma atribuicao
+ *
+ * Chamado depois de a expressao ser numerada e traduzida. A variavel passa a
+ *  guardar o valor da expressao, ou um valor novo se o valor eh desconhecido ou
+ *  de outro tipo.
+ *
+ * @param nome char* : nome da variavel atribuida.
+ * @param tipo signed char : tipo da variavel.
+ * @param expressao tExpressao : expressao atribuida.
+ * @param valor unsigned int : numero do valor da expressao, de otmExpressao.
+ */
+void otmAtribuicao(char *nome, signed char tipo, tExpressao expressao, unsigned int valor) {
+
+	auto tValorVariavel *variavel;
+
+	if (!otimizacaoAtiva || !(variavel = _otmVariavel(nome, tipo)))
+		return;
+
+	variavel->tipo = tipo;
+	variavel->valor = valor && expressao && expressao->tipo == tipo ? valor : ++proximoValor;
+	variavel->desde = ++relogioValores;
+}
+
+/**
+ * Registra uma leitura
+ *
+ * As variaveis do comando le, na fila temporaria, passam a guardar valores
+ *  novos. As que ainda nao sao acompanhadas ganham um valor novo quando
+ *  aparecerem.
+ */
+void otmLeitura(void) {
+
+	auto tValorVariavel *variavel;
+	register unsigned int i;
+
+	if (!otimizacaoAtiva)
+		return;
+
+	for (i = 0; i < temporaria.total; ++i)
+		if ((variavel = _otmBuscar(temporaria.dado[i].nome))) {
+			variavel->valor = ++proximoValor;
+			variavel->desde = ++relogioValores;
+		}
+}
+
+/**
+ * Salva o estado
+ *
+ * Usado no se, antes dos ramos.
+ *
+ * @return tEstadoValores* : copia do estado atual ou NULL se faltar memoria.
+ */
+tEstadoValores *otmSalvar(void) {
+
+	auto tEstadoValores *copia = (tEstadoValores*) malloc(sizeof(tEstadoValores));
+
+	if (copia)
+		*copia = estadoValores;
+
+	return copia;
+}
+
+/**
+ * Restaura um estado salvo, que continua salvo.
+ *
+ * @param estado tEstadoValores* : estado salvo; NULL descarta o estado atual.
+ */
+void otmRestaurar(tEstadoValores *estado) {
+
+	if (estado)
+		estadoValores = *estado;
+	else
+		otmReiniciar();
+}
+
+/**
+ * Verifica se uma variavel mantem o valor em um estado. Funcao para uso interno.
+ *
+ * @param estado tEstadoValores* : estado ao final de um ramo.
+ * @param variavel tValorVariavel* : variavel no estado anterior aos ramos.
+ * @return diferente de zero se o ramo nao alterou a variavel.
+ */
+static signed char _otmMantem(tEstadoValores *estado, tValorVariavel *variavel) {
+
+	register unsigned int i;
+
+	for (i = 0; i < estado->totalVariaveis; ++i)
+		if (!strcmp(estado->variaveis[i].nome, variavel->nome))
+			return estado->variaveis[i].valor == variavel->valor;
+
+	return 0;
+}
+
+/**
+ * Junta os ramos de um se
+ *
+ * Chamado ao final do se com o estado do ultimo ramo em vigor. O estado passa a
+ *  ser o anterior aos ramos, com valores novos para as variaveis que algum ramo
+ *  alterou. Libera os estados salvos.
+ *
+ * @param anterior tEstadoValores* : estado salvo antes dos ramos.
+ * @param ramo tEstadoValores* : estado salvo ao final do primeiro ramo.
+ * @param doisRamos signed char : diferente de zero se o se tem senao, zero se o
+ *                                 estado anterior eh o do outro ramo.
+ */
+void otmJuntar(tEstadoValores *anterior, tEstadoValores *ramo, signed char doisRamos) {
+
+	auto tEstadoValores *atual = otmSalvar();
+	register unsigned int i;
+
+	if (anterior && atual && (ramo || !doisRamos)) {
+		for (i = 0; i < anterior->totalVariaveis; ++i)
+			if (!_otmMantem(atual, &anterior->variaveis[i])
+					|| (ramo && !_otmMantem(ramo, &anterior->variaveis[i]))) {
+				anterior->variaveis[i].valor = ++proximoValor;
+				anterior->variaveis[i].desde = ++relogioValores;
+			}
+
+		estadoValores = *anterior;
+	}
+	else
+		otmReiniciar();
+
+	free(atual);
+	free(anterior);
+	free(ramo);
+}
+
+#endif /* _OTIMIZADOR_H_ */
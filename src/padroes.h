@@ -18,6 +18,9 @@
 #ifndef _PADROES_H_
 #define _PADROES_H_
 
+/*includes*/
+#include <limits.h>
+
 /*defines*/
 /*defines globais*/
 #define SUCESSO 0
@@ -69,6 +72,16 @@
 #define SENAO 129
 #define VAR 130
 
+/*conjuntos de tokens*/
+/**
+ * Bit que representa o token de codigo c em um tConjuntoTokens. Os codigos vao
+ *  de COMENTARIO_ERRO ate VAR, 36 bits, que cabem no unsigned long dos alvos
+ *  de 64 bits do compilador; a verificacao abaixo dos tipos recusa os alvos
+ *  em que nao cabem.
+ */
+#define CONJ(c) ((tConjuntoTokens) 1 << ((c) - COMENTARIO_ERRO))
+#define PERTENCE(c, conjunto) (CONJ(c) & (conjunto)) /**testa se o token c esta no conjunto*/
+
 /*codigos para a arvore*/
 #define NO_REDUNDANTE 13
 
@@ -77,17 +90,40 @@ typedef int tControle;
 
 typedef short int tCodigoToken;
 
+typedef unsigned long tConjuntoTokens; /**conjunto de codigos de tokens, um bit por codigo*/
+
+/*sem compilar se os codigos de tokens nao cabem em um tConjuntoTokens*/
+typedef char tConjuntoTokensCabe[sizeof(tConjuntoTokens) * CHAR_BIT > VAR - COMENTARIO_ERRO ? 1 : -1];
+
 /**
  * @brief Estrutura do token.
  *
- * Modela como sera a estrutura do token dentro deste compilador.
+ * Modela como sera a estrutura do token dentro deste compilador.
  */
 typedef struct {
-	char cadeia[256]; /**cadeia referente ao token*/
+	char *cadeia; /**cadeia referente ao token, guardada no fluxo de tokens*/
 	tCodigoToken signo; /**significado desta cadeia*/
 	unsigned int linha; /**linha do token*/
 } tToken;
 
+/**
+ * @brief Fluxo de tokens empacotado.
+ *
+ * Todos os tokens produzidos pelo analisador lexico, guardados como uma
+ *  estrutura de vetores: um vetor para cada campo do token, indexados pela
+ *  posicao do token no fonte. As cadeias ficam em um unico bloco de lexemas
+ *  terminados por '\0', de modo que o analisador sintatico apenas aponta para
+ *  elas sem copia-las.
+ */
+typedef struct {
+	unsigned char *signo; /**codigo de cada token, todos os codigos cabem em um byte*/
+	unsigned int *linha; /**linha de cada token*/
+	unsigned int *coluna; /**coluna de cada token*/
+	unsigned int *lexema; /**deslocamento da cadeia do token no bloco de lexemas*/
+	unsigned int total; /**numero de tokens no fluxo*/
+	unsigned int capacidade; /**numero de tokens alocados em cada vetor*/
+} tFluxoTokens;
+
 /**
  * @brief dados que serao utilizados nas estrutura
  *
@@ -95,10 +131,10 @@ typedef struct {
  * Apresenta os dados inseridos na pilha.
  */
 typedef struct {
-	char nome[256]; /**nome da variavel ou procedimento*/
+	const char *nome; /**nome da variavel ou procedimento, na tabela de nomes (nomes.h) se for global*/
 	signed char tipo; /**variavel interia ou variavel real*/
-	unsigned int genI; /**valor de uma variavel inteiro ou numero de parametros inteiros em um procedimento*/
-	float genF; /**valor de uma variavel real ou numero de parametros reais em um procedimento*/
+	unsigned int genI; /**valor de uma variavel inteiro ou numero da assinatura de um procedimento*/
+	float genF; /**valor de uma variavel real*/
 } tDados;
 
 typedef unsigned long long tChave; /**tipo utilizado para chave inteiro sem sinal de 64 bits*/
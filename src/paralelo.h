@@ -0,0 +1,275 @@
+/**
+ * paralelo.h
+ *
+ * Compilacao paralela dos procedimentos.
+ *
+ * Declaradas as variaveis globais, cada procedimento depende apenas de consultas
+ *  ao escopo global. Os procedimentos sao entao divididos em lotes contiguos de
+ *  tamanho parecido, em tokens, e cada lote eh compilado por um processo filho
+ *  (fork), que herda o fluxo de tokens e as tabelas do analisador sem precisar
+ *  de nenhuma sincronizacao. O filho declara as assinaturas dos procedimentos
+ *  anteriores ao seu lote, compila o lote escrevendo o codigo em um arquivo
+ *  temporario e termina indicando se houve erros. O pai concatena os arquivos
+ *  temporarios na ordem do fonte e declara todas as assinaturas para compilar o
+ *  corpo principal.
+ * Se algum lote tiver erros, ou se os limites encontrados pela varredura dos
+ *  tokens nao coincidirem com os do analisador sintatico, o trabalho dos filhos
+ *  eh descartado e os procedimentos sao compilados em sequencia, assim os
+ *  diagnosticos sao sempre os da compilacao sequencial.
+ * O modulo so eh compilado com EQUIDNAS_PARALELO (make PARALELO=1), pois usa
+ *  fork e nao mostrou ganho nas medidas. Sem ele os procedimentos sao sempre
+ *  compilados em sequencia.
+ *
+ * @see sintatico
+ * @see geradorCodigo
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _PARALELO_H_
+#define _PARALELO_H_
+
+#ifdef EQUIDNAS_PARALELO
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "geradorCodigo.h"
+#include "incremental.h"
+#include "expansao.h"
+#include "rastro.h"
+
+/*defines*/
+#define MAX_PROCESSOS 64 /*limite de processos da compilacao paralela*/
+#define LIMITES_INICIAIS 64 /*capacidade inicial do vetor de limites dos procedimentos*/
+#define BLOCO_COPIA 4096 /*bytes copiados de um arquivo temporario por vez*/
+
+/*trazendo funcao de outro modulo*/
+extern unsigned int getIndiceToken(void);
+extern void irParaToken(unsigned int);
+extern tCodigoToken signoToken(unsigned int);
+extern tControle getToken(tToken*);
+extern tControle sintAssinaturaProcedimento(tToken*);
+extern tControle sintProcedimento(tToken*);
+extern unsigned int contErros;
+
+/*variaveis globais*/
+static unsigned int processos = 1; /**numero de processos, um para compilar em sequencia*/
+static unsigned int *limites; /**primeiro token de cada procedimento e o seguinte ao ultimo*/
+static unsigned int totalLimites; /**numero de limites*/
+static unsigned int capacidadeLimites; /**numero de limites alocados*/
+
+/*funcoes e procedimentos*/
+/**
+ * Define o numero de processos da compilacao paralela.
+ *
+ * @param total unsigned int : numero de processos, ate MAX_PROCESSOS; zero ou um
+ *                              compila em sequencia.
+ */
+void iniciarParalelo(unsigned int total) {
+
+	processos = !total ? 1 : total > MAX_PROCESSOS ? MAX_PROCESSOS : total;
+}
+
+/**
+ * Acrescenta um limite ao vetor, que cresce dobrando de tamanho. Funcao para
+ *  uso interno.
+ *
+ * @param indice unsigned int : posicao do token.
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+static tControle _anexarLimite(unsigned int indice) {
+
+	auto unsigned int *novo;
+
+	if (totalLimites == capacidadeLimites) {
+
+		if (!(novo = (unsigned int*) crescerVetor(limites, &capacidadeLimites, totalLimites + 1,
+				LIMITES_INICIAIS, sizeof(unsigned int))))
+			return ERRO;
+		limites = novo;
+	}
+
+	limites[totalLimites++] = indice;
+	return SUCESSO;
+}
+
+/**
+ * Delimita os procedimentos.
+ *
+ * Preenche o vetor de limites a partir do primeiro procedimento. Funcao para
+ *  uso interno.
+ *
+ * @param inicio unsigned int : posicao do primeiro token procedimento.
+ * @return SUCESSO se todos os procedimentos foram delimitados e ha tokens depois
+ *          do ultimo.
+ */
+static tControle _delimitarProcedimentos(unsigned int inicio) {
+
+	totalLimites = 0;
+
+	while (signoToken(inicio) == PROCEDIMENTO) {
+		if (_anexarLimite(inicio) != SUCESSO || !(inicio = expFimProcedimento(inicio)))
+			return ERRO;
+	}
+
+	return _anexarLimite(inicio) == SUCESSO && signoToken(inicio) ? SUCESSO : ERRO;
+}
+
+/**
+ * Declara as assinaturas de um intervalo de procedimentos, pulando seus corpos.
+ *  Funcao para uso interno.
+ *
+ * @param token tToken* : recebe o token seguinte ao intervalo.
+ * @param de unsigned int : primeiro procedimento.
+ * @param ate unsigned int : procedimento seguinte ao ultimo.
+ */
+static void _declararAssinaturas(tToken *token, unsigned int de, unsigned int ate) {
+
+	for (; de < ate; ++de) {
+		irParaToken(limites[de]);
+		getToken(token);
+		sintAssinaturaProcedimento(token);
+		expRegistrar(limites[de], limites[de + 1]);
+	}
+
+	irParaToken(limites[ate]);
+	getToken(token);
+}
+
+/**
+ * Trabalho de um processo filho.
+ *
+ * Declara as assinaturas dos procedimentos anteriores ao lote e compila o lote,
+ *  conferindo se cada procedimento termina onde a varredura indicou. Nao retorna.
+ *  Funcao para uso interno.
+ *
+ * @param token tToken* : token atual.
+ * @param de unsigned int : primeiro procedimento do lote.
+ * @param ate unsigned int : procedimento seguinte ao ultimo do lote.
+ * @param saida FILE* : arquivo temporario do lote.
+ */
+static void _compilarLote(tToken *token, unsigned int de, unsigned int ate, FILE *saida) {
+
+	auto signed char desalinhado = 0;
+
+	rastroProcessoFilho();
+	rastroInicio("lote", "paralelo");
+
+	gecRedirecionar(saida);
+
+	_declararAssinaturas(token, 0, de);
+
+	for (; de < ate && !desalinhado; ++de)
+		if (sintProcedimento(token) != SUCESSO || getIndiceToken() - 1 != limites[de + 1])
+			desalinhado = 1;
+
+	fflush(saida);
+
+	rastroFim(NULL);
+	gravarRastro(0);
+
+	_exit(contErros || desalinhado ? 1 : 0);
+}
+
+/**
+ * Compila os procedimentos em paralelo.
+ *
+ * Chamado com o primeiro token depois das variaveis globais. Com um so processo,
+ *  na compilacao incremental ou se os procedimentos nao puderem ser delimitados
+ *  nada eh feito.
+ *
+ * @param token tToken* : token atual, recebe o token seguinte aos procedimentos.
+ * @return SUCESSO se os procedimentos foram compilados, ERRO se devem ser
+ *          compilados em sequencia.
+ */
+tControle compilarEmParalelo(tToken *token) {
+
+	auto FILE *temporarios[MAX_PROCESSOS];
+	auto pid_t filhos[MAX_PROCESSOS];
+	auto unsigned int primeiros[MAX_PROCESSOS + 1];
+	auto unsigned int lotes = 0, inicio = getIndiceToken() - 1, lote, tokens;
+	auto tControle erro = SUCESSO;
+	auto char bloco[BLOCO_COPIA];
+	auto size_t lidos;
+	auto int situacao;
+	register unsigned int i;
+
+	if (processos < 2 || incrementalAtivo || contErros || token->signo != PROCEDIMENTO
+			|| _delimitarProcedimentos(inicio) != SUCESSO || totalLimites < 3)
+		return ERRO;
+
+	/*lotes contiguos com numeros de tokens parecidos*/
+	tokens = limites[totalLimites - 1] - inicio;
+	for (i = 0; i + 1 < totalLimites; ++i) {
+		lote = (unsigned int) ((unsigned long) (limites[i] - inicio) * processos / tokens);
+		if (!lotes || lote >= lotes)
+			primeiros[lotes++] = i;
+	}
+	primeiros[lotes] = totalLimites - 1;
+
+	fflush(NULL);
+
+	for (i = 0; i < lotes; ++i) {
+
+		filhos[i] = -1;
+		if (!(temporarios[i] = tmpfile()) || (filhos[i] = fork()) < 0) {
+			erro = ERRO;
+			break;
+		}
+
+		if (!filhos[i])
+			_compilarLote(token, primeiros[i], primeiros[i + 1], temporarios[i]);
+	}
+	lotes = i < lotes ? i + 1 : lotes;
+
+	/*espera todos os filhos, na ordem dos lotes*/
+	for (i = 0; i < lotes; ++i)
+		if (filhos[i] > 0 && (waitpid(filhos[i], &situacao, 0) != filhos[i]
+				|| !WIFEXITED(situacao) || WEXITSTATUS(situacao)))
+			erro = ERRO;
+		else if (filhos[i] <= 0)
+			erro = ERRO;
+
+	/*concatena o codigo dos lotes na ordem do fonte*/
+	for (i = 0; i < lotes; ++i) {
+
+		if (erro == SUCESSO) {
+			rewind(temporarios[i]);
+			while ((lidos = fread(bloco, 1, BLOCO_COPIA, temporarios[i])))
+				gecGeraTrecho(bloco, lidos);
+		}
+
+		if (temporarios[i])
+			fclose(temporarios[i]);
+	}
+
+	if (erro == SUCESSO)
+		_declararAssinaturas(token, 0, totalLimites - 1);
+	else
+		irParaToken(inicio + 1);
+
+	free(limites);
+	limites = NULL;
+	totalLimites = capacidadeLimites = 0;
+
+	return erro;
+}
+
+#else
+
+/*sem a compilacao paralela os procedimentos sao compilados em sequencia*/
+#define iniciarParalelo(total)
+#define compilarEmParalelo(token) ERRO
+
+#endif /* EQUIDNAS_PARALELO */
+
+#endif /* _PARALELO_H_ */
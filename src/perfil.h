@@ -0,0 +1,459 @@
+/**
+ * perfil.h
+ *
+ * Instrumentacao do programa traduzido e uso do perfil de execucao.
+ *
+ * Com a instrumentacao ligada o codigo gerado conta as entradas em cada
+ *  procedimento e, em cada se e enquanto, quantas vezes a condicao foi
+ *  verdadeira e quantas foi falsa. Os contadores ficam em um vetor do programa
+ *  traduzido, descrito por um vetor de chaves, e sao gravados ao fim da execucao
+ *  no arquivo arqDestino.perfil, uma linha "chave contagem" por contador:
+ *
+ *    procedimento nome contagem
+ *    se linha coluna verdadeiro contagem
+ *    enquanto linha coluna falso contagem
+ *
+ * As chaves usam o nome do procedimento e a posicao do comando no fonte, assim
+ *  o perfil continua servindo depois de mudancas que nao movem os comandos
+ *  medidos.
+ * Uma compilacao seguinte pode ler o perfil: a condicao quase sempre verdadeira
+ *  ou quase sempre falsa eh marcada com __builtin_expect, o procedimento muito
+ *  chamado eh marcado hot e tem as chamadas expandidas em linha ate um limite
+ *  maior, e o procedimento nunca chamado eh marcado cold e nao eh expandido. O
+ *  GCC agrupa as funcoes hot e as cold em secoes proprias, o que ordena os
+ *  procedimentos pelo uso. As marcas sao macros que somem fora do GCC.
+ *
+ * @see geradorCodigo
+ * @see expansao
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _PERFIL_H_
+#define _PERFIL_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "espalhamento.h"
+
+/*defines*/
+#define EXTENSAO_PERFIL ".perfil" /*acrescentada ao nome do arquivo gerado*/
+#define PONTOS_INICIAIS 64 /*capacidade inicial do vetor de chaves dos contadores*/
+#define CONTAGENS_INICIAIS 64 /*capacidade inicial do vetor de contagens lidas*/
+#define LINHA_PERFIL_INICIAL 128 /*capacidade inicial da linha lida do perfil, que cresce*/
+#define TAMANHO_CHAVE_CONDICAO 64 /*chave de um se ou enquanto: comando, linha, coluna e resultado*/
+#define AMOSTRAS_MINIMAS 16 /*execucoes de uma condicao para confiar na tendencia*/
+#define TENDENCIA 9 /*um resultado tantas vezes mais frequente que o outro eh esperado*/
+#define FRACAO_QUENTE 10 /*procedimento hot: entradas acima desta fracao do maximo*/
+#define FATOR_EXPANSAO_QUENTE 4 /*multiplica o limite de expansao dos procedimentos hot*/
+
+#define CONDICAO_NEUTRA 0 /*sem tendencia conhecida*/
+#define CONDICAO_VERDADEIRA 1 /*quase sempre verdadeira*/
+#define CONDICAO_FALSA -1 /*quase sempre falsa*/
+
+#define PROCEDIMENTO_NEUTRO 0 /*sem marca*/
+#define PROCEDIMENTO_QUENTE 1 /*muito chamado*/
+#define PROCEDIMENTO_FRIO -1 /*nunca chamado*/
+
+/*novos tipos*/
+/**
+ * @brief Contagem lida do perfil.
+ */
+typedef struct {
+	char *chave; /**chave do contador*/
+	unsigned long contagem; /**soma das contagens com essa chave*/
+} tContagem;
+
+/*variaveis globais*/
+static signed char instrumentando; /**diferente de zero se o codigo gerado conta as execucoes*/
+static char **pontos; /**chave de cada contador do codigo gerado*/
+static unsigned int totalPontos; /**numero de contadores*/
+static unsigned int capacidadePontos; /**chaves alocadas*/
+static tContagem *contagens; /**contagens do perfil lido, ordenadas pela chave*/
+static unsigned int totalContagens; /**numero de chaves no perfil*/
+static signed char perfilCarregado; /**diferente de zero se ha um perfil em uso*/
+static unsigned long maiorEntrada; /**maior numero de entradas em um procedimento*/
+static tChave impressaoPerfil; /**impressao digital do arquivo de perfil, zero sem perfil*/
+
+/*funcoes e procedimentos*/
+/**
+ * Liga a instrumentacao do codigo gerado.
+ */
+void iniciarInstrumentacao(void) {
+
+	instrumentando = 1;
+}
+
+/**
+ * Compara duas contagens pela chave, para qsort e bsearch. Funcao para uso
+ *  interno.
+ */
+static int _compararContagens(const void *a, const void *b) {
+
+	return strcmp(((const tContagem*) a)->chave, ((const tContagem*) b)->chave);
+}
+
+/**
+ * Le uma linha de qualquer tamanho, aumentando o vetor quando ela nao cabe.
+ *  Funcao para uso interno.
+ *
+ * @param arquivo FILE* : arquivo aberto.
+ * @param linha char** : vetor da linha, que pode ser trocado.
+ * @param capacidade size_t* : tamanho do vetor.
+ * @return diferente de zero se uma linha foi lida.
+ */
+static int _lerLinhaPerfil(FILE *arquivo, char **linha, size_t *capacidade) {
+
+	auto size_t tamanho = 0, maior;
+	auto char *nova;
+
+	for (;;) {
+
+		if (*capacidade - tamanho < 2) {
+
+			maior = *capacidade ? 2 * *capacidade : LINHA_PERFIL_INICIAL;
+
+			if (!(nova = (char*) realloc(*linha, maior)))
+				return 0;
+			*linha = nova;
+			*capacidade = maior;
+		}
+
+		if (!fgets(*linha + tamanho, (int) (*capacidade - tamanho), arquivo))
+			return tamanho != 0;
+
+		tamanho += strlen(*linha + tamanho);
+		if ((*linha)[tamanho - 1] == '\n')
+			return 1;
+	}
+}
+
+/**
+ * Le um arquivo de perfil
+ *
+ * Guarda as contagens ordenadas pela chave, somando as chaves repetidas, e a
+ *  impressao digital do arquivo, que entra no cache da compilacao incremental.
+ *  Linhas mal formadas sao ignoradas.
+ *
+ * @param nomeArquivo const char* : arquivo gravado pelo programa instrumentado.
+ * @return SUCESSO, ou ERRO se o arquivo nao pode ser lido ou faltar memoria.
+ */
+tControle carregarPerfil(const char *nomeArquivo) {
+
+	auto FILE *arquivoPerfil;
+	auto char *linha = NULL, *espaco, *fimNumero;
+	auto size_t tamanhoLinha = 0;
+	auto unsigned long contagem;
+	auto unsigned int capacidade = 0, i, j;
+	auto tContagem *novas;
+	auto tChave impressao = ESPALHAMENTO_BASE;
+	register const char *c;
+
+	if (!(arquivoPerfil = fopen(nomeArquivo, "rt")))
+		return ERRO;
+
+	while (_lerLinhaPerfil(arquivoPerfil, &linha, &tamanhoLinha)) {
+
+		for (c = linha; *c; ++c)
+			impressao = ESPALHAR(impressao, *c);
+
+		linha[strcspn(linha, "\r\n")] = '\0';
+		if (!(espaco = strrchr(linha, ' ')) || espaco == linha)
+			continue;
+
+		contagem = strtoul(espaco + 1, &fimNumero, 10);
+		if (fimNumero == espaco + 1 || *fimNumero)
+			continue;
+		*espaco = '\0';
+
+		if (totalContagens == capacidade) {
+
+			if (!(novas = (tContagem*) crescerVetor(contagens, &capacidade, totalContagens + 1,
+					CONTAGENS_INICIAIS, sizeof(tContagem)))) {
+				free(linha);
+				fclose(arquivoPerfil);
+				return ERRO;
+			}
+			contagens = novas;
+		}
+
+		if (!(contagens[totalContagens].chave = (char*) malloc(strlen(linha) + 1))) {
+			free(linha);
+			fclose(arquivoPerfil);
+			return ERRO;
+		}
+		strcpy(contagens[totalContagens].chave, linha);
+		contagens[totalContagens++].contagem = contagem;
+	}
+
+	free(linha);
+	fclose(arquivoPerfil);
+
+	if (totalContagens)
+		qsort(contagens, totalContagens, sizeof(tContagem), _compararContagens);
+
+	/*somando as chaves repetidas, como as de perfis de varias execucoes juntados*/
+	for (i = j = 0; i < totalContagens; ++i)
+		if (j && !strcmp(contagens[j - 1].chave, contagens[i].chave)) {
+			contagens[j - 1].contagem += contagens[i].contagem;
+			free(contagens[i].chave);
+		}
+		else
+			contagens[j++] = contagens[i];
+	totalContagens = j;
+
+	for (i = 0; i < totalContagens; ++i)
+		if (!strncmp(contagens[i].chave, "procedimento ", 13) && contagens[i].contagem > maiorEntrada)
+			maiorEntrada = contagens[i].contagem;
+
+	perfilCarregado = 1;
+	impressaoPerfil = impressao ? impressao : 1;
+
+	return SUCESSO;
+}
+
+/**
+ * Procura uma contagem no perfil. Funcao para uso interno.
+ *
+ * @param chave const char* : chave do contador.
+ * @return a contagem ou NULL se a chave nao esta no perfil.
+ */
+static const tContagem *_buscarContagem(const char *chave) {
+
+	auto tContagem modelo;
+
+	if (!totalContagens)
+		return NULL;
+
+	modelo.chave = (char*) chave;
+	return (const tContagem*) bsearch(&modelo, contagens, totalContagens, sizeof(tContagem),
+			_compararContagens);
+}
+
+/**
+ * Tendencia de uma condicao segundo o perfil
+ *
+ * @param comando const char* : "se" ou "enquanto".
+ * @param linha unsigned int : linha do comando no fonte.
+ * @param coluna unsigned int : coluna do comando no fonte.
+ * @return signed char : CONDICAO_VERDADEIRA, CONDICAO_FALSA ou CONDICAO_NEUTRA.
+ */
+signed char perfilCondicao(const char *comando, unsigned int linha, unsigned int coluna) {
+
+	auto char chave[TAMANHO_CHAVE_CONDICAO];
+	auto const tContagem *verdadeira, *falsa;
+
+	if (!perfilCarregado)
+		return CONDICAO_NEUTRA;
+
+	sprintf(chave, "%.16s %u %u verdadeiro", comando, linha, coluna);
+	verdadeira = _buscarContagem(chave);
+	sprintf(chave, "%.16s %u %u falso", comando, linha, coluna);
+	falsa = _buscarContagem(chave);
+
+	if (!verdadeira || !falsa || verdadeira->contagem + falsa->contagem < AMOSTRAS_MINIMAS)
+		return CONDICAO_NEUTRA;
+
+	if (verdadeira->contagem >= TENDENCIA * falsa->contagem)
+		return CONDICAO_VERDADEIRA;
+	if (falsa->contagem >= TENDENCIA * verdadeira->contagem)
+		return CONDICAO_FALSA;
+
+	return CONDICAO_NEUTRA;
+}
+
+/**
+ * Uso de um procedimento segundo o perfil
+ *
+ * Um procedimento que nao aparece no perfil, como um procedimento novo, fica
+ *  neutro.
+ *
+ * @param nome const char* : nome do procedimento.
+ * @return signed char : PROCEDIMENTO_QUENTE, PROCEDIMENTO_FRIO ou PROCEDIMENTO_NEUTRO.
+ */
+signed char perfilProcedimento(const char *nome) {
+
+	auto char *chave;
+	auto const tContagem *entradas;
+
+	if (!perfilCarregado || !(chave = (char*) malloc(strlen(nome) + sizeof("procedimento "))))
+		return PROCEDIMENTO_NEUTRO;
+
+	sprintf(chave, "procedimento %s", nome);
+	entradas = _buscarContagem(chave);
+	free(chave);
+
+	if (!entradas)
+		return PROCEDIMENTO_NEUTRO;
+
+	if (!entradas->contagem)
+		return PROCEDIMENTO_FRIO;
+	if (entradas->contagem >= maiorEntrada / FRACAO_QUENTE)
+		return PROCEDIMENTO_QUENTE;
+
+	return PROCEDIMENTO_NEUTRO;
+}
+
+/**
+ * Limite de expansao de um procedimento
+ *
+ * @param nome const char* : nome do procedimento.
+ * @param limite unsigned int : limite de expansao em linha, em tokens.
+ * @return unsigned int : limite para o procedimento, ajustado pelo perfil.
+ */
+unsigned int perfilLimiteExpansao(const char *nome, unsigned int limite) {
+
+	switch (perfilProcedimento(nome)) {
+	case PROCEDIMENTO_QUENTE:
+		return FATOR_EXPANSAO_QUENTE * limite;
+	case PROCEDIMENTO_FRIO:
+		return 0;
+	default:
+		return limite;
+	}
+}
+
+/**
+ * Cria um contador no codigo gerado
+ *
+ * @param formato const char* : formato da chave, como no printf.
+ * @param nome const char* : nome do procedimento ou comando da chave.
+ * @param linha unsigned int : linha do comando, se o formato usar.
+ * @param coluna unsigned int : coluna do comando, se o formato usar.
+ * @return unsigned int : posicao do contador no vetor de contadores; se faltar
+ *          memoria, o primeiro contador, que sempre existe.
+ */
+unsigned int perfilContador(const char *formato, const char *nome, unsigned int linha,
+		unsigned int coluna) {
+
+	auto char **novos;
+	auto char *chave;
+
+	if (totalPontos == capacidadePontos) {
+
+		if (!(novos = (char**) crescerVetor(pontos, &capacidadePontos, totalPontos + 1,
+				PONTOS_INICIAIS, sizeof(char*))))
+			return 0;
+		pontos = novos;
+	}
+
+	/*nome, dois numeros e o texto fixo do formato*/
+	if ((chave = (char*) malloc(strlen(formato) + strlen(nome) + 24)))
+		sprintf(chave, formato, nome, linha, coluna);
+
+	pontos[totalPontos] = chave;
+	return totalPontos++;
+}
+
+/**
+ * Escreve uma cadeia como literal de C. Funcao para uso interno.
+ *
+ * @param saida FILE* : arquivo gerado.
+ * @param cadeia const char* : cadeia a ser escrita.
+ */
+static void _escreverLiteral(FILE *saida, const char *cadeia) {
+
+	fputc('"', saida);
+
+	for (; *cadeia; ++cadeia) {
+		if (*cadeia == '"' || *cadeia == '\\')
+			fputc('\\', saida);
+		fputc(*cadeia, saida);
+	}
+
+	fputc('"', saida);
+}
+
+/**
+ * Escreve o inicio do codigo gerado
+ *
+ * Declaracoes usadas pelos contadores e as macros das marcas do perfil.
+ *
+ * @param saida FILE* : arquivo gerado.
+ */
+void escreverPreambuloPerfil(FILE *saida) {
+
+	if (instrumentando)
+		fprintf(saida, "#include <stdlib.h>\n"
+				"unsigned long eq_contadores[];\n"
+				"static void eq_gravarPerfil(void);\n");
+
+	if (perfilCarregado)
+		fprintf(saida, "#ifdef __GNUC__\n"
+				"#define EQ_PROVAVEL(c) __builtin_expect(!!(c), 1)\n"
+				"#define EQ_IMPROVAVEL(c) __builtin_expect(!!(c), 0)\n"
+				"#define EQ_QUENTE __attribute__((hot))\n"
+				"#define EQ_FRIO __attribute__((cold))\n"
+				"#else\n"
+				"#define EQ_PROVAVEL(c) (c)\n"
+				"#define EQ_IMPROVAVEL(c) (c)\n"
+				"#define EQ_QUENTE\n"
+				"#define EQ_FRIO\n"
+				"#endif\n");
+}
+
+/**
+ * Escreve os contadores
+ *
+ * Define o vetor de contadores, o vetor das chaves e a funcao que grava o
+ *  perfil, registrada com atexit no inicio do main.
+ *
+ * @param saida FILE* : arquivo gerado.
+ * @param nomeGerado const char* : nome do arquivo gerado, base do nome do perfil.
+ */
+void escreverContadores(FILE *saida, const char *nomeGerado) {
+
+	register unsigned int i;
+
+	if (!instrumentando)
+		return;
+
+	fprintf(saida, "\nunsigned long eq_contadores[%u];\n", totalPontos ? totalPontos : 1);
+	fprintf(saida, "static const char *const eq_chaves[%u] = {", totalPontos ? totalPontos : 1);
+	for (i = 0; i < totalPontos; ++i) {
+		fprintf(saida, "%s\n", i ? "," : "");
+		_escreverLiteral(saida, pontos[i] ? pontos[i] : "");
+	}
+	fprintf(saida, "%s};\n", totalPontos ? "" : "0");
+
+	fprintf(saida, "\nstatic void eq_gravarPerfil(void) {\n"
+			"FILE *perfil = fopen(");
+	_escreverLiteral(saida, nomeGerado);
+	fprintf(saida, " \"" EXTENSAO_PERFIL "\", \"w\");\n"
+			"unsigned int i;\n"
+			"if (!perfil)\nreturn;\n"
+			"for (i = 0; i < %uu; ++i)\n"
+			"fprintf(perfil, \"%%s %%lu\\n\", eq_chaves[i], eq_contadores[i]);\n"
+			"fclose(perfil);\n}\n", totalPontos);
+}
+
+/**
+ * Encerra a instrumentacao e o perfil
+ *
+ * Desaloca as chaves dos contadores e as contagens lidas.
+ */
+void fecharPerfil(void) {
+
+	register unsigned int i;
+
+	for (i = 0; i < totalPontos; ++i)
+		free(pontos[i]);
+	for (i = 0; i < totalContagens; ++i)
+		free(contagens[i].chave);
+
+	free(pontos);
+	free(contagens);
+
+	pontos = NULL;
+	contagens = NULL;
+	totalPontos = capacidadePontos = totalContagens = 0;
+}
+
+#endif /* _PERFIL_H_ */
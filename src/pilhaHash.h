@@ -17,7 +17,10 @@
 /*includes*/
 #include <stdio.h>
 #include <malloc.h>
+#include <string.h>
 #include "padroes.h"
+#include "desempenho.h"
+#include "espalhamento.h"
 
 /*tipos de dados e estruturas*/
 
@@ -29,7 +32,7 @@
  */
 struct sNodoPilha {
 
-	tChave chave; /**chave para distincao na pilha, primeiros 8 bits escopo, restante hash*/
+	tChave chave; /**hash do nome, para descartar os nos sem comparar os nomes*/
 	tDados dado; /**dado relacionado a chave*/
 
 	struct sNodoPilha *anterior; /**ponteiro para nodo anterior*/
@@ -42,14 +45,28 @@ typedef tNodoPilha* tPilhaHash; /**tipo para pilha, ponteiro para o no topo*/
 /*prototipos de funcoes e procedimentos*/
 void criarPilha(tPilhaHash*);
 short int inserirPilha(tPilhaHash*, tDados*);
-short int buscarPilha(tPilhaHash*, char*, tDados*);
+short int buscarPilha(tPilhaHash*, const char*, tDados*);
 tControle pop(tPilhaHash*, tDados*);
-void apagarPilha(tPilhaHash*, char*);
+void apagarPilha(tPilhaHash*, const char*);
 void destruirPilha(tPilhaHash*);
 
-static tChave _hash(char*);
-
 /*funcoes e procedimentos*/
+/**
+ * Verifica se um no guarda um nome. Funcao para uso interno.
+ *
+ * A chave descarta quase todos os nos; o nome so eh comparado quando as chaves
+ *  coincidem, e nomes da tabela de nomes sao iguais ja pelo endereco.
+ *
+ * @param no const tNodoPilha* : no comparado.
+ * @param key tChave : hash do nome.
+ * @param nome const char* : nome procurado.
+ * @return signed char : diferente de zero se o no guarda o nome.
+ */
+static signed char _mesmoNome(const tNodoPilha *no, tChave key, const char *nome) {
+
+	return no->chave == key && (no->dado.nome == nome || !strcmp(no->dado.nome, nome));
+}
+
 /**
  * Faz a criacao da pilha.
  *
@@ -74,12 +91,12 @@ void criarPilha(tPilhaHash *pilha) {
  */
 short int inserirPilha(tPilhaHash *pilhaNova, tDados *valor) {
 
-	auto tChave key = _hash(valor->nome);
+	auto tChave key = espalharPolinomial(valor->nome);
 	auto tNodoPilha *pilha;
 	pilha = *pilhaNova;
 
-	/*buscara enquanto houver pilha e a chave for diferente*/
-	while (pilha && pilha->chave != key)
+	/*buscara enquanto houver pilha e o nome for diferente*/
+	while (pilha && !_mesmoNome(pilha, key, valor->nome))
 		pilha = pilha->anterior;
 
 	if (*pilhaNova)
@@ -112,27 +129,28 @@ short int inserirPilha(tPilhaHash *pilhaNova, tDados *valor) {
  * Busca uma chave na pilha, se encontrar o seu dado sera devolvido em valor.
  *
  * @param pilha tPilhaHash* : endereco da pilha.
- * @param string char* : nome que esta sendo procurado.
+ * @param string const char* : nome que esta sendo procurado.
  * @param valor tDados* : dado de saida caso no tenha sido encontrado.
  *
  * @return short int : SUCESSO se encontrou e ERRO caso contrario.
  */
-short int buscarPilha(tPilhaHash *pilha, char *string, tDados *valor) {
+short int buscarPilha(tPilhaHash *pilha, const char *string, tDados *valor) {
 
-	auto tChave key = _hash(string);
+	auto tChave key;
 	auto tNodoPilha *aux = *pilha;
 
-	while (aux && aux->chave != key)
+	MEDIR_INICIO(SUBSISTEMA_PILHA);
+
+	key = espalharPolinomial(string);
+
+	while (aux && !_mesmoNome(aux, key, string))
 		aux = aux->anterior;
 
-	if (aux)
-		if (aux->chave == key) {
-			*valor = aux->dado;
-			return SUCESSO;
-		} else
-			return ERRO;
-	else
-		return ERRO;
+	if (aux) {
+		*valor = aux->dado;
+		return MEDIR_FIM_VALOR(SUCESSO);
+	} else
+		return MEDIR_FIM_VALOR(ERRO);
 }
 
 tControle pop(tPilhaHash* pilha, tDados* entrada) {
@@ -156,19 +174,19 @@ tControle pop(tPilhaHash* pilha, tDados* entrada) {
  * Faz a remocao de um elemento da pilha, eh necessario apenas a sua identificacao.
  *
  * @param pilha tPilhaHash* : endereco da pilha.
- * @param string char* : string procurada.
+ * @param string const char* : string procurada.
  */
-void apagarPilha(tPilhaHash *pilha, char *string) {
+void apagarPilha(tPilhaHash *pilha, const char *string) {
 
-	auto tChave key = _hash(string);
+	auto tChave key = espalharPolinomial(string);
 	auto tNodoPilha *aux = *pilha, *proximo = *pilha;
 
-	while (aux && aux->chave != key) {
+	while (aux && !_mesmoNome(aux, key, string)) {
 		proximo = aux;
 		aux = aux->anterior;
 	}
 
-	if (!aux) {
+	if (aux) {
 		if (*pilha == aux)
 			*pilha = aux->anterior;
 		else
@@ -195,24 +213,4 @@ void destruirPilha(tPilhaHash *pilha) {
 	}
 }
 
-/**
- * Encontra o hash de uma palavra
- *
- * Faz a somatoria do valor ASCII de cada caracter da string que recebe multiplicado pela
- *  sua posicao na string. Funcao para uso interno. Retornara um inteiro de 54 bits.
- *
- * @param string char* : palavra de entrada
- * @return tChave : hash calculado
- */
-static tChave _hash(char *string) {
-
-	auto tChave valor = 0;
-	register unsigned short int i = 0;
-
-	while (*string)
-		valor += (tChave) ((unsigned short int) (*string++) * ++i);
-
-	return valor;
-}
-
 #endif
@@ -0,0 +1,284 @@
+/**
+ * rastro.h
+ *
+ * Rastro dos eventos da compilacao no formato de eventos do Chrome.
+ *
+ * Com o rastro ligado (--trace) sao marcados o inicio e o fim das fases da
+ *  compilacao, de cada procedimento analisado, de cada verificacao semantica e
+ *  de cada descarga do arquivo destino. Os eventos ficam em um vetor na memoria
+ *  do processo e sao escritos de uma vez ao final, assim o custo da marcacao eh
+ *  apenas ler o relogio e guardar o evento.
+ * O compilador nao usa threads, mas a compilacao paralela usa processos: cada
+ *  filho comeca um vetor proprio, sem nenhuma sincronizacao, e ao terminar
+ *  acrescenta seus eventos ao arquivo com uma unica escrita. Os eventos de todos
+ *  os processos levam o numero do processo principal e o do processo que os
+ *  gerou como thread, entao os lotes aparecem como linhas paralelas no
+ *  visualizador (chrome://tracing ou Perfetto).
+ *
+ * @see paralelo
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _RASTRO_H_
+#define _RASTRO_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "diagnosticos.h"
+
+/*defines*/
+#define EVENTOS_INICIAIS 1024 /*capacidade inicial do vetor de eventos*/
+
+/**
+ * Marca uma chamada, que deve resultar em um valor inteiro, como um evento do
+ *  rastro e resulta no valor da chamada.
+ */
+#define RASTREAR(nome, categoria, chamada) \
+	(rastroInicio(nome, categoria), rastroFimValor(chamada))
+
+/*novos tipos*/
+/**
+ * @brief Um evento do rastro.
+ *
+ * Os nomes e categorias sao constantes do compilador; o detalhe, quando ha,
+ *  fica copiado no bloco de cadeias do rastro.
+ */
+typedef struct {
+	const char *nome; /**nome do evento, NULL no fim de um evento*/
+	const char *categoria; /**categoria do evento*/
+	double tempo; /**instante em microssegundos*/
+	long detalhe; /**deslocamento do detalhe no bloco de cadeias, -1 se nao houver*/
+} tEvento;
+
+/*variaveis globais*/
+static const char *arqRastro; /**nome do arquivo do rastro, NULL com o rastro desligado*/
+static tEvento *eventos; /**eventos deste processo*/
+static unsigned int totalEventos; /**numero de eventos guardados*/
+static unsigned int capacidadeEventos; /**numero de eventos alocados*/
+static char *cadeiasRastro; /**detalhes dos eventos, cada um terminado por '\0'*/
+static size_t tamanhoCadeiasRastro; /**bytes ocupados no bloco de cadeias*/
+static size_t capacidadeCadeiasRastro; /**bytes alocados no bloco de cadeias*/
+static long processoRastro; /**numero do processo principal*/
+
+/*funcoes e procedimentos*/
+/**
+ * Instante atual em microssegundos. Funcao para uso interno.
+ *
+ * @return double : tempo de um relogio monotono.
+ */
+static double _agora(void) {
+
+	auto struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+/**
+ * Guarda um evento. Funcao para uso interno.
+ *
+ * Se faltar memoria o evento eh perdido, o rastro nunca interrompe a compilacao.
+ *
+ * @param nome const char* : nome do evento, NULL para o fim de um evento.
+ * @param categoria const char* : categoria do evento.
+ * @param detalhe const char* : detalhe a copiar, NULL se nao houver.
+ */
+static void _guardarEvento(const char *nome, const char *categoria, const char *detalhe) {
+
+	auto double tempo = _agora();
+	auto tEvento *novo;
+	auto char *novas;
+	auto size_t tamanho;
+
+	if (totalEventos == capacidadeEventos) {
+
+		if (!(novo = (tEvento*) crescerVetor(eventos, &capacidadeEventos, totalEventos + 1,
+				EVENTOS_INICIAIS, sizeof(tEvento))))
+			return;
+		eventos = novo;
+	}
+
+	novo = eventos + totalEventos;
+	novo->nome = nome;
+	novo->categoria = categoria;
+	novo->detalhe = -1;
+
+	if (detalhe) {
+
+		tamanho = strlen(detalhe) + 1;
+		if (tamanhoCadeiasRastro + tamanho > capacidadeCadeiasRastro) {
+
+			if (!(novas = (char*) realloc(cadeiasRastro, 2 * capacidadeCadeiasRastro + tamanho)))
+				return;
+			cadeiasRastro = novas;
+			capacidadeCadeiasRastro = 2 * capacidadeCadeiasRastro + tamanho;
+		}
+
+		memcpy(cadeiasRastro + tamanhoCadeiasRastro, detalhe, tamanho);
+		novo->detalhe = (long) tamanhoCadeiasRastro;
+		tamanhoCadeiasRastro += tamanho;
+	}
+
+	novo->tempo = tempo;
+	++totalEventos;
+}
+
+/**
+ * Liga o rastro.
+ *
+ * Cria o arquivo do rastro ja com a abertura do vetor de eventos.
+ *
+ * @param nomeArquivo const char* : nome do arquivo do rastro.
+ * @return SUCESSO, ou ERRO se o arquivo nao pode ser criado.
+ */
+tControle iniciarRastro(const char *nomeArquivo) {
+
+	auto FILE *arquivo;
+
+	if (!(arquivo = fopen(nomeArquivo, "wt")))
+		return ERRO;
+	fprintf(arquivo, "[\n");
+	fclose(arquivo);
+
+	arqRastro = nomeArquivo;
+	processoRastro = (long) getpid();
+	return SUCESSO;
+}
+
+/**
+ * Marca o inicio de um evento.
+ *
+ * @param nome const char* : nome do evento.
+ * @param categoria const char* : categoria do evento.
+ */
+void rastroInicio(const char *nome, const char *categoria) {
+
+	if (arqRastro)
+		_guardarEvento(nome, categoria, NULL);
+}
+
+/**
+ * Marca o fim do ultimo evento iniciado.
+ *
+ * @param detalhe const char* : nome do que foi processado, como um
+ *         procedimento, ou NULL.
+ */
+void rastroFim(const char *detalhe) {
+
+	if (arqRastro)
+		_guardarEvento(NULL, NULL, detalhe);
+}
+
+/**
+ * Marca o fim do ultimo evento iniciado, para o uso em RASTREAR.
+ *
+ * @param valor int : valor da chamada marcada.
+ * @return int : o proprio valor.
+ */
+int rastroFimValor(int valor) {
+
+	rastroFim(NULL);
+	return valor;
+}
+
+/**
+ * Comeca o rastro de um processo filho.
+ *
+ * Os eventos herdados do pai sao dele, o filho guarda apenas os seus.
+ */
+void rastroProcessoFilho(void) {
+
+	totalEventos = 0;
+	tamanhoCadeiasRastro = 0;
+}
+
+/**
+ * Acrescenta os eventos deste processo ao arquivo do rastro.
+ *
+ * O texto dos eventos eh montado na memoria e escrito com um unico write em
+ *  modo de acrescimo, assim os eventos dos processos da compilacao paralela
+ *  nao se misturam.
+ *
+ * @param final signed char : diferente de zero no processo principal, que fecha
+ *         o vetor de eventos depois de todos os filhos terminarem.
+ */
+void gravarRastro(signed char final) {
+
+	auto FILE *texto;
+	auto char *bloco = NULL;
+	auto size_t tamanho = 0;
+	auto long processo = (long) getpid();
+	auto int arquivo;
+	auto size_t escritos = 0;
+	auto ssize_t parte;
+	register unsigned int i;
+
+	if (!arqRastro || !(texto = open_memstream(&bloco, &tamanho)))
+		return;
+
+	for (i = 0; i < totalEventos; ++i) {
+
+		fprintf(texto, "{\"ph\": \"%c\", \"ts\": %.3f, \"pid\": %ld, \"tid\": %ld",
+				eventos[i].nome ? 'B' : 'E', eventos[i].tempo, processoRastro, processo);
+
+		if (eventos[i].nome)
+			fprintf(texto, ", \"name\": \"%s\", \"cat\": \"%s\"", eventos[i].nome,
+					eventos[i].categoria);
+
+		if (eventos[i].detalhe >= 0) {
+			fprintf(texto, ", \"args\": {\"nome\": ");
+			escreverCadeiaJson(texto, cadeiasRastro + eventos[i].detalhe);
+			fprintf(texto, "}");
+		}
+
+		fprintf(texto, "},\n");
+	}
+
+	/*o ultimo evento, sem virgula, da nome ao processo*/
+	if (final)
+		fprintf(texto, "{\"ph\": \"M\", \"pid\": %ld, \"tid\": %ld, \"name\": \"process_name\", "
+				"\"args\": {\"name\": \"equidnas\"}}\n]\n", processoRastro, processo);
+
+	fclose(texto);
+
+	if ((arquivo = open(arqRastro, O_WRONLY | O_APPEND)) >= 0) {
+		while (escritos < tamanho && (parte = write(arquivo, bloco + escritos, tamanho - escritos)) > 0)
+			escritos += (size_t) parte;
+		close(arquivo);
+	}
+
+	free(bloco);
+	totalEventos = 0;
+}
+
+/**
+ * Finaliza o rastro.
+ *
+ * Grava os eventos do processo principal, fecha o arquivo do rastro e libera
+ *  os vetores.
+ */
+void fecharRastro(void) {
+
+	gravarRastro(1);
+
+	free(eventos);
+	free(cadeiasRastro);
+	eventos = NULL;
+	cadeiasRastro = NULL;
+	totalEventos = capacidadeEventos = 0;
+	tamanhoCadeiasRastro = capacidadeCadeiasRastro = 0;
+	arqRastro = NULL;
+}
+
+#endif /* _RASTRO_H_ */
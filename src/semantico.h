@@ -21,19 +21,29 @@
 #include <stdio.h>
 #include <malloc.h>
 #include "padroes.h"
+#include "vetor.h"
 #include "arvore.h"
 #include "pilhaHash.h"
+#include "assinaturas.h"
+#include "nomes.h"
+#include "fila.h"
+#include "expressao.h"
 #include "lexico.h"
 #include "sintatico.h"
 #include "geradorCodigo.h"
 
 /*evitar declaracoes implicitas*/
 extern void mensagemErro(const char*);
+extern void incRegistrarDependencia(const tDados*);
 
 /*variaveis globais*/
 static tArvore escopoGlobal; /**arvore que sera utilizada para o escopo global*/
 static tPilhaHash escopoLocal; /**pilha que sera utilizada para os escopos locais (de procedimentos por exemplo)*/
-tPilhaHash temporaria; /**pilha que sera utilizada temporariamente para facilitar algumas manipulacoes*/
+tFila temporaria; /**identificadores da lista em analise, na ordem do fonte*/
+static char *tipos; /**forma em montagem, da declaracao ou da chamada de um procedimento*/
+static unsigned int totalTipos; /**parametros na forma em montagem*/
+static unsigned int capacidadeTipos; /**bytes alocados para a forma em montagem*/
+static signed char tipoDesconhecido; /**diferente de zero se um argumento da chamada nao tem tipo*/
 
 /**
  * Inicia a analise semantica
@@ -44,24 +54,44 @@ void analisadorSemantico(void) {
 
 	criarArvore(&escopoGlobal);
 	criarPilha(&escopoLocal);
-	criarPilha(&temporaria);
+	criarFila(&temporaria);
 
 }
 
+/**
+ * Busca no escopo global.
+ *
+ * Busca um identificador na arvore do escopo global e, se encontrado, o registra
+ *  como dependencia do procedimento em analise, para a recompilacao incremental.
+ *  Funcao para uso interno.
+ *
+ * @param nome const char* : nome do identificador.
+ * @param saida tDados* : recebe os dados do identificador.
+ * @return SUCESSO se o identificador existe no escopo global.
+ */
+static tControle _buscarGlobal(const char *nome, tDados *saida) {
+
+	if (buscarArvore(escopoGlobal, nome, saida) != SUCESSO)
+		return ERRO;
+
+	incRegistrarDependencia(saida);
+	return SUCESSO;
+}
+
 /**
  * Verifica declaracao de procedimentos
  *
  * Servira na verificacao do escopo de um procedimento, eh interessante no sentido que os procedimentos sao
  *  identificadores que pertencerao apenas ao escopo local.
  *
- * @param token tToken : token com o nome do procedimento.
+ * @param token const tToken* : token com o nome do procedimento.
  * @return SUCESSO se o procedimento ja foi declarado.
  */
-tControle semVerDeclProc(tToken token) {
+tControle semVerDeclProc(const tToken *token) {
 
 	auto tDados procedimento;
 
-	if (buscarArvore(escopoGlobal, token.cadeia, &procedimento) == SUCESSO)
+	if (_buscarGlobal(token->cadeia, &procedimento) == SUCESSO)
 		if (procedimento.tipo == PROCEDIMENTO)
 			return SUCESSO;
 
@@ -70,22 +100,19 @@ tControle semVerDeclProc(tToken token) {
 }
 
 /**
- * Verifica a declaracao de variaveis
+ * Verifica a declaracao de uma variavel pelo nome. Funcao para uso interno.
  *
- * Servira para verificar se uma variavel ja foi declarada, a verificacao difere-se da de procedimento pelo
- *  fato de variaveis poderem estar em escopo local.
- *
- * @param token tToken : token com o nome da variavel.
+ * @param nome const char* : nome da variavel.
  * @return SUCESSO se a variavel existe.
  */
-tControle semVerDeclVar(tToken token) {
+static tControle _verDeclVar(const char *nome) {
 
 	auto tDados variavel;
 
-	if (buscarPilha(&escopoLocal, token.cadeia, &variavel) == SUCESSO)
+	if (buscarPilha(&escopoLocal, nome, &variavel) == SUCESSO)
 		return SUCESSO;
 	else {
-		if (buscarArvore(escopoGlobal, token.cadeia, &variavel) == SUCESSO)
+		if (_buscarGlobal(nome, &variavel) == SUCESSO)
 			if (variavel.tipo != PROCEDIMENTO)
 				return SUCESSO;
 	}
@@ -93,26 +120,40 @@ tControle semVerDeclVar(tToken token) {
 	return ERRO;
 }
 
+/**
+ * Verifica a declaracao de variaveis
+ *
+ * Servira para verificar se uma variavel ja foi declarada, a verificacao difere-se da de procedimento pelo
+ *  fato de variaveis poderem estar em escopo local.
+ *
+ * @param token const tToken* : token com o nome da variavel.
+ * @return SUCESSO se a variavel existe.
+ */
+tControle semVerDeclVar(const tToken *token) {
+
+	return _verDeclVar(token->cadeia);
+}
+
 /**
  * Verifica declaracoes redundantes
  *
  * Serve para verificar se uma variavel e/ou procedimento ja foi declarado dentro daquele
  *  escopo, no caso de procedimento, apenas global.
  *
- * @param token tToken : token com o nome do procedimento e/ou funcao.
- * @param ehVariavel char : 1 se for variavel e zero se procedimento.
+ * @param nome const char* : nome da variavel e/ou procedimento.
+ * @param ehLocal char : 1 se for do escopo local e zero se do global.
  * @return SUCESSO se nao foi declarado anteriormente.
  */
-tControle semVerDeclRedundante(tToken token, char ehLocal) {
+tControle semVerDeclRedundante(const char *nome, char ehLocal) {
 
 	auto tDados variavel;
 
 	if (ehLocal)
-		if (buscarPilha(&escopoLocal, token.cadeia, &variavel) != SUCESSO)
+		if (buscarPilha(&escopoLocal, nome, &variavel) != SUCESSO)
 			return SUCESSO;
 		else
 			;
-	else if (buscarArvore(escopoGlobal, token.cadeia, &variavel) != SUCESSO)
+	else if (buscarArvore(escopoGlobal, nome, &variavel) != SUCESSO)
 		return SUCESSO;
 
 	mensagemErro("Variavel/Procedimento ja declarada.");
@@ -120,26 +161,104 @@ tControle semVerDeclRedundante(tToken token, char ehLocal) {
 }
 
 /**
- * Verifica Atribuicao
+ * Tipo de uma variavel
  *
- * Sera utilizado para verificar se um atribuicao eh valida para uma determinada exprecao
+ * Procura a variavel no escopo local e depois no global.
  *
- * @return tControle : SUCESSO se a atribuicao eh valida.
+ * @param nome char* : nome da variavel.
+ * @return signed char : INTEIRO ou REAL, zero se nao for uma variavel declarada.
  */
-tControle semVerAtribuicao(void) {
+signed char semTipoVariavel(char *nome) {
 
-	auto signed short int ehReal = 0;
-	auto tDados saida;
+	auto tDados variavel;
 
-	while (pop(&temporaria, &saida) == SUCESSO)
-		if (saida.tipo == NUMERO_REAL || saida.tipo == REAL)
-			ehReal = 1;
+	if (buscarPilha(&escopoLocal, nome, &variavel) != SUCESSO
+			&& _buscarGlobal(nome, &variavel) != SUCESSO)
+		return 0;
 
-	if (ehReal)
-		if (saida.tipo == NUMERO_INTEIRO || saida.tipo == INTEIRO) {
-			mensagemErro("Numero real atribuido a um inteiro.");
-			return ERRO;
-		}
+	if (variavel.tipo == REAL || variavel.tipo == NUMERO_REAL)
+		return REAL;
+	else if (variavel.tipo == INTEIRO || variavel.tipo == NUMERO_INTEIRO)
+		return INTEIRO;
+
+	return 0;
+}
+
+signed char semTiparExpressao(tExpressao);
+
+/**
+ * Tipa um no do ramo esquerdo, cujo operando esquerdo ja foi tipado. Funcao
+ *  para uso interno.
+ *
+ * @param expressao tExpressao : no tipado.
+ * @param pai tExpressao : pai do no, nao usado.
+ * @param esquerda void* : signed char com o tipo do operando esquerdo, recebe o
+ *         tipo do no.
+ */
+static void _semTiparNo(tExpressao expressao, tExpressao pai, void *esquerda) {
+
+	auto signed char *tipo = (signed char*) esquerda;
+	auto signed char direita;
+
+	switch (expressao->operador) {
+
+	case NUMERO_REAL:
+		expressao->tipo = REAL;
+		break;
+
+	case NUMERO_INTEIRO:
+		expressao->tipo = INTEIRO;
+		break;
+
+	case IDENTIFICADOR:
+		expressao->tipo = semTipoVariavel(expressao->cadeia) == REAL ? REAL : INTEIRO;
+		break;
+
+	default:
+		direita = semTiparExpressao(expressao->direita);
+		expressao->tipo = *tipo == REAL || direita == REAL ? REAL : INTEIRO;
+	}
+
+	*tipo = expressao->tipo;
+}
+
+/**
+ * Tipa uma expressao
+ *
+ * Anota cada no da arvore, de baixo para cima, como inteiro ou real: as folhas
+ *  pelo tipo do numero ou da variavel, as operacoes e agrupamentos pelo tipo dos
+ *  operandos, sendo reais se algum operando for real. A divisao de inteiros eh
+ *  inteira. Variaveis nao declaradas, ja relatadas, sao tidas como inteiras. O
+ *  ramo esquerdo eh percorrido em laco por percorrerExpressao.
+ *
+ * @param expressao tExpressao : raiz da expressao, pode ser nula.
+ * @return signed char : tipo da expressao, INTEIRO ou REAL.
+ */
+signed char semTiparExpressao(tExpressao expressao) {
+
+	auto signed char tipo = INTEIRO;
+
+	percorrerExpressao(expressao, NULL, _semTiparNo, &tipo);
+
+	return tipo;
+}
+
+/**
+ * Verifica Atribuicao
+ *
+ * Sera utilizado para verificar se um atribuicao eh valida para uma determinada exprecao,
+ *  que ja deve estar tipada.
+ *
+ * @param tipo signed char : tipo da variavel atribuida, zero se nao for variavel.
+ * @param expressao tExpressao : expressao atribuida.
+ * @return tControle : SUCESSO se a atribuicao eh valida.
+ */
+tControle semVerAtribuicao(signed char tipo, tExpressao expressao) {
+
+	if (tipo == INTEIRO && expressao && expressao->tipo == REAL) {
+		mensagemErro("Numero real atribuido a um inteiro.");
+		return ERRO;
+	}
 
 	return SUCESSO;
 }
@@ -148,64 +267,107 @@ tControle semVerAtribuicao(void) {
  * Verifica os argumentos de le e escreve.
  *
  * Sera utilizado para verificar se os argumentos de le/escreve sao de mesmo tipo, para uma
- *  determinada chamada.
+ *  determinada chamada. Os tipos sao comparados com o do primeiro argumento
+ *  declarado; os nao declarados ja foram relatados e ficam de fora.
  *
  * @return tControle : SUCESSO se a lista de argumentos eh valida.
  */
 tControle semVerLeEscreve(void) {
 
-	auto tDados primeiro, saida;
-	auto tToken temp;
+	auto const tDados *primeiro = NULL;
+	register unsigned int i;
 
-	if (pop(&temporaria, &primeiro) != SUCESSO) {
+	if (!temporaria.total) {
 
 		mensagemErro("Comando le/escreve sem parametros.");
 		return ERRO;
-	} else {
-
-		strcpy(temp.cadeia, primeiro.nome);
-		semVerDeclVar(temp);
 	}
 
-	while (pop(&temporaria, &saida) == SUCESSO) {
-		strcpy(temp.cadeia, saida.nome);
-		if (semVerDeclVar(temp) == SUCESSO)
-			if (saida.tipo != primeiro.tipo) {
+	for (i = 0; i < temporaria.total; ++i) {
+		if (_verDeclVar(temporaria.dado[i].nome) == SUCESSO) {
+			if (!primeiro)
+				primeiro = temporaria.dado + i;
+			else if (temporaria.dado[i].tipo != primeiro->tipo) {
 				mensagemErro(
 						"Comando Le/Escreve deve manipular variaveis de mesmo tipo.");
 				return ERRO;
 			}
+		}
+	}
+
+	return SUCESSO;
+}
+
+/**
+ * Acrescenta um tipo a forma em montagem. Funcao para uso interno.
+ *
+ * @param tipo char : TIPO_INTEIRO ou TIPO_REAL.
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+static tControle _anexarTipo(char tipo) {
+
+	auto char *novos;
+
+	if (totalTipos == capacidadeTipos) {
+
+		if (!(novos = (char*) crescerVetor(tipos, &capacidadeTipos, totalTipos + 1, 16, sizeof(char))))
+			return ERRO;
+		tipos = novos;
 	}
 
+	tipos[totalTipos++] = tipo;
 	return SUCESSO;
 }
 
+/**
+ * Registra um argumento de chamada.
+ *
+ * Acrescenta o tipo do argumento a forma da chamada em analise. Argumentos que
+ *  nao sao variaveis declaradas ja foram relatados e impedem a verificacao.
+ *
+ * @param token const tToken* : token com o nome do argumento.
+ */
+void semArgumento(const tToken *token) {
+
+	switch (semTipoVariavel(token->cadeia)) {
+	case INTEIRO:
+		_anexarTipo(TIPO_INTEIRO);
+		break;
+	case REAL:
+		_anexarTipo(TIPO_REAL);
+		break;
+	default:
+		tipoDesconhecido = 1;
+	}
+}
+
 /**
  * Verifica se os argumentos de um procedimento.
  *
  * Sera utilizado para verificar se os argumentos de um procedimento seguem as especificacoes.
+ *  A forma dos argumentos registrados por semArgumento eh buscada na tabela de
+ *  assinaturas e comparada com a assinatura do procedimento, considerando o
+ *  numero, o tipo e a ordem dos parametros.
  *
- * @param nomeProc char* : nome do procedimento a ser avaliado. * @return tControle : SUCESSO se a lista de argumentos eh valida.
+ * @param nomeProc char* : nome do procedimento a ser avaliado.
+ * @return tControle : SUCESSO se a lista de argumentos eh valida.
  */
 tControle semVerParametros(char *nomeProc) {
 
-	int contInteiros = 0, contReal = 0;
 	auto tDados saida;
+	auto unsigned int assinatura = buscarAssinatura(tipos, totalTipos);
+	auto signed char desconhecido = tipoDesconhecido;
 
-	while (pop(&temporaria, &saida) == SUCESSO) {
-		if (saida.tipo == NUMERO_INTEIRO || saida.tipo == INTEIRO)
-			contInteiros++;
-		else
-			contReal++;
-	}
+	totalTipos = 0;
+	tipoDesconhecido = 0;
 
-	if (buscarArvore(escopoGlobal, nomeProc, &saida) == SUCESSO)
-		if (saida.genF == contReal && saida.genI == contInteiros) {
-			return SUCESSO;
-	}
-	else
+	/*procedimento nao declarado ou argumento sem tipo, ja relatados*/
+	if (_buscarGlobal(nomeProc, &saida) != SUCESSO || saida.tipo != PROCEDIMENTO || desconhecido)
 		return ERRO;
 
+	if (saida.genI == assinatura)
+		return SUCESSO;
+
 	mensagemErro("Numero ou tipo de parametros invalido.");
 
 	return ERRO;
@@ -215,122 +377,134 @@ tControle semVerParametros(char *nomeProc) {
  * Manipulacao da pilha temporaria
  *
  * Empilhar na pilha temporaria, para ser utilizada posteriormente por outra
- *  funcao semantica.
+ *  funcao semantica. O nome aponta para o bloco de lexemas, que dura toda a
+ *  compilacao; so as declaracoes globais vao para a tabela de nomes, assim os
+ *  nomes locais nao ficam guardados depois do seu procedimento.
  *
- * @param token tToken : o token a ser empilhado
+ * @param token const tToken* : o token a ser empilhado
  */
-void semEmpilhaTemp(tToken token) {
+void semEmpilhaTemp(const tToken *token) {
 
 	auto tDados entrada, temp;
 
-	strcpy(entrada.nome, token.cadeia);
-	entrada.tipo = token.signo;
+	entrada.nome = token->cadeia;
+	entrada.tipo = token->signo;
 
 	if (buscarPilha(&escopoLocal, entrada.nome, &temp) == SUCESSO)
 		entrada.tipo = temp.tipo;
 	else
-		if (buscarArvore(escopoGlobal, entrada.nome, &temp) == SUCESSO)
+		if (_buscarGlobal(entrada.nome, &temp) == SUCESSO)
 			entrada.tipo = temp.tipo;
 
-	inserirPilha(&temporaria, &entrada);
+	inserirFila(&temporaria, &entrada);
 }
 
 /**
- * Manipulacao da pilha temporaria
+ * Manipulacao da fila temporaria
  *
- * Desempilha na pilha temporaria, para ser utilizada posteriormente por outra
- *  funcao semantica.
- *
- * @param saida tToken* : o token a ser desempilhado
- */
-void semDesempilhaTemp(tToken *s) {
-
-	auto tDados saida;
-	pop(&temporaria, &saida);
-
-	strcpy(s->cadeia, saida.nome);
-}
-
-/**
- * Manipulacao da pilha temporaria
- *
- * Desempilha e desaloca o pilha temporaria toda.
+ * Esvazia a fila temporaria toda, a memoria fica para a proxima lista.
  *
  */
 void semApagaTemp(void) {
-	destruirPilha(&temporaria);
+	esvaziarFila(&temporaria);
 }
 
 /**
  * Faz a declaracao de uma variavel
  *
  * Este procedimento sera utilizado para a insercao de uma variavel
- *  na lista de escopo global ou local. Para tanto, faz uso da pilha
- *  de temporarios
+ *  na lista de escopo global ou local, na ordem do fonte. Para tanto, faz uso
+ *  da fila de temporarios, que fica vazia.
  *
  * @param escopo int : escopo da varivavel
  * @param tipo signed char : tipo da variavel (inteiro ou real)
  */
 void semDeclareVariaveis(int escopo, signed char tipo) {
 
-	auto tDados saida;
-	auto tToken temp;
+	auto tDados *saida = temporaria.dado, *fim = temporaria.dado + temporaria.total;
 
 	if (escopo)
-		while (pop(&temporaria, &saida) == SUCESSO) {
+		for (; saida < fim; ++saida) {
 
-			saida.tipo = temp.signo = tipo;
-			strcpy(temp.cadeia, saida.nome);
+			saida->tipo = tipo;
 
-			if (semVerDeclRedundante(temp, 1) == SUCESSO)
-				inserirPilha(&escopoLocal, &saida);
+			if (semVerDeclRedundante(saida->nome, 1) == SUCESSO)
+				inserirPilha(&escopoLocal, saida);
 		}
 	else
-		while (pop(&temporaria, &saida) == SUCESSO) {
+		for (; saida < fim; ++saida) {
 
-			saida.tipo = temp.signo = tipo;
-			strcpy(temp.cadeia, saida.nome);
+			saida->tipo = tipo;
 
-			if (semVerDeclRedundante(temp, 0) == SUCESSO)
-				inserirArvore(&escopoGlobal, saida);
+			if (semVerDeclRedundante(saida->nome, 0) == SUCESSO
+					&& (saida->nome = internarNome(saida->nome)))
+				inserirArvore(&escopoGlobal, *saida);
 		}
+
+	esvaziarFila(&temporaria);
 }
 
 /**
- * Declara um procedimento
+ * Declara a assinatura de um procedimento
  *
- * Coloca um procedimento e seus atributos na arvore do escopo global, junto
- *  a alguns outros processamentos necessarios.
+ * Coloca um procedimento com o numero da sua assinatura na arvore do escopo
+ *  global. Usado tambem para os procedimentos reaproveitados da compilacao
+ *  anterior, que nao tem seus parametros analisados.
  *
  * @param nome char* : nome do procedimento.
+ * @param assinatura unsigned int : numero da assinatura, de internarAssinatura.
+ * @return SUCESSO se o procedimento nao foi declarado antes.
  */
-tControle semDeclareProcedimento(char *nome) {
+tControle semDeclareAssinatura(char *nome, unsigned int assinatura) {
 
 	auto tDados proc;
 
-	strcpy(proc.nome, nome);
+	if (!(proc.nome = internarNome(nome)))
+		return ERRO;
 	proc.tipo = PROCEDIMENTO;
-
-	auto signed int inteiros = 0, reais = 0;
-	auto tPilhaHash aux = escopoLocal;
-
-	while (aux) {
-		if (aux->dado.tipo == NUMERO_INTEIRO || aux->dado.tipo == INTEIRO)
-			++inteiros;
-		else
-			++reais;
-		aux = aux->anterior;
-	}
-
-	proc.genI = inteiros;
-	proc.genF = reais;
+	proc.genI = assinatura;
+	proc.genF = 0;
 
 	if (inserirArvore(&escopoGlobal, proc) != SUCESSO) {
 		mensagemErro("Procedimento ja declarado.");
 		return ERRO;
 	} else
 		return SUCESSO;
+}
+
+/**
+ * Declara um procedimento
+ *
+ * Coloca um procedimento e seus atributos na arvore do escopo global, junto
+ *  a alguns outros processamentos necessarios. Chamado logo apos os parametros,
+ *  quando o escopo local contem apenas eles. O escopo local eh uma pilha, com
+ *  o ultimo parametro no topo, entao a forma eh preenchida do fim para o inicio.
+ *
+ * @param nome char* : nome do procedimento.
+ * @return SUCESSO, ou ERRO se ja foi declarado ou faltou memoria para a forma.
+ */
+tControle semDeclareProcedimento(char *nome) {
+
+	auto tPilhaHash aux;
+	register unsigned int i = 0;
+
+	for (aux = escopoLocal; aux; aux = aux->anterior)
+		++i;
+
+	for (totalTipos = 0; totalTipos < i;)
+		if (_anexarTipo(TIPO_INTEIRO) != SUCESSO) {
+			totalTipos = 0;
+			return ERRO;
+		}
 
+	for (aux = escopoLocal; aux && i; aux = aux->anterior)
+		tipos[--i] = aux->dado.tipo == NUMERO_INTEIRO || aux->dado.tipo == INTEIRO
+				? TIPO_INTEIRO : TIPO_REAL;
+
+	i = totalTipos;
+	totalTipos = 0;
+
+	return semDeclareAssinatura(nome, internarAssinatura(tipos, i));
 }
 
 /**
@@ -344,6 +518,37 @@ void semLimpaLocal(void) {
 	destruirPilha(&escopoLocal);
 }
 
+/**
+ * Verifica se um nome eh local
+ *
+ * @param nome const char* : nome procurado.
+ * @return signed char : diferente de zero se o nome esta no escopo local.
+ */
+signed char semEhLocal(const char *nome) {
+
+	auto tDados dados;
+
+	return escopoLocal && buscarPilha(&escopoLocal, nome, &dados) == SUCESSO;
+}
+
+/**
+ * Troca o escopo local
+ *
+ * Usado na expansao de procedimentos, que analisa o corpo do procedimento
+ *  expandido com o seu proprio escopo local e depois devolve o escopo de quem
+ *  fez a chamada.
+ *
+ * @param novo tPilhaHash : escopo local a ser usado.
+ * @return tPilhaHash : o escopo local anterior.
+ */
+tPilhaHash semTrocarLocal(tPilhaHash novo) {
+
+	auto tPilhaHash anterior = escopoLocal;
+
+	escopoLocal = novo;
+	return anterior;
+}
+
 /**
  * Encerra a analise semantica
  *
@@ -353,7 +558,13 @@ void fecharSemantico(void) {
 
 	destruirArvore(&escopoGlobal);
 	destruirPilha(&escopoLocal);
-	destruirPilha(&temporaria);
+	destruirFila(&temporaria);
+	destruirAssinaturas();
+	destruirNomes();
+
+	free(tipos);
+	tipos = NULL;
+	totalTipos = capacidadeTipos = 0;
 }
 
 #endif /* SEMANTICO_H_ */
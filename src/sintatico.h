@@ -24,50 +24,92 @@
 /*includes*/
 #include <stdio.h>
 #include "padroes.h"
+#include "diagnosticos.h"
+#include "expressao.h"
 #include "lexico.h"
 #include "semantico.h"
 #include "geradorCodigo.h"
+#include "incremental.h"
+#include "paralelo.h"
+#include "expansao.h"
+#include "otimizador.h"
+#include "rastro.h"
+#include "memoria.h"
 
 /*trazendo funcao de outro modulo*/
 extern unsigned int getLinhaAtual(void);
+extern unsigned int getColunaAtual(void);
 extern tControle getToken(tToken*);
 
+/*conjuntos de sincronizacao do modo panico, montados em tempo de compilacao*/
+#define SINC_PRIMEIROS_CMD (CONJ(LE) | CONJ(ESCREVE) | CONJ(ENQUANTO) | CONJ(SE) \
+		| CONJ(IDENTIFICADOR) | CONJ(INICIO)) /**primeiros de cmd*/
+#define SINC_PRIMEIROS_EXPRESSAO (CONJ(MAIS) | CONJ(MENOS) | CONJ(IDENTIFICADOR) \
+		| CONJ(NUMERO_INTEIRO) | CONJ(NUMERO_REAL) | CONJ(ABRE_PARENTESES)) /**primeiros de expressao*/
+#define SINC_SEGUIDORES_FATOR (CONJ(ASTERISCO) | CONJ(BARRA) | CONJ(MAIS) \
+		| CONJ(MENOS) | CONJ(FIM) | CONJ(ABRE_PARENTESES) | CONJ(ENTAO)) /**seguidores de fator*/
+#define SINC_FIM_CMD (CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(SENAO)) /**terminadores de cmd*/
+#define SINC_DECLARACOES (CONJ(VAR) | CONJ(PROCEDIMENTO) | CONJ(INICIO)) /**inicio de dc_v, dc_p e corpo*/
+#define SINC_TIPO (CONJ(REAL) | CONJ(INTEIRO)) /**tipos de variaveis*/
+
 /*variavel global*/
 unsigned int contErros; /** Conta o numero de erros*/
 static unsigned int escopo = 0; /**escopo -> 0: global 1: local*/
 
 /*prototipo de funcoes em ordem alfabetica*/
-void analiseSintatica();
+tControle analiseSintatica();
+void concluirAnalise(tControle);
 void mensagemErro(const char *);
-tControle modoPanico(tToken*, const unsigned short int*,const unsigned short int);
+tControle modoPanico(tToken*, const tConjuntoTokens);
+tControle sintAssinaturaProcedimento(tToken*);
+tControle sintCabecalhoProcedimento(tToken*, char**);
 tControle sintCmd(tToken*);
 tControle sintComando(tToken*);
 tControle sintCondicao(tToken*);
+void sintConferirMemoria(void);
+tControle sintCorpoExpandido(tToken*);
 tControle sintCorpoPrograma(tToken*);
 tControle sintDeclaracaoProcedimentos(tToken*);
 tControle sintDeclaracaoVariaveis(tToken*);
-tControle sintExpressao(tToken*);
-tControle sintFator(tToken *token);
+tControle sintExpressao(tToken*, tExpressao*);
+tControle sintFator(tToken *token, tExpressao*);
 tControle sintListaArg(tToken*);
 tControle sintListaParametro(tToken*);
-tControle sintMaisFator(tToken *token);
-tControle sintOutrosTermos(tToken*);
+tControle sintMaisFator(tToken *token, tExpressao*);
+tControle sintOutrosTermos(tToken*, tExpressao*);
+tControle sintProcedimento(tToken*);
 tControle sintPrograma(tToken*);
-tControle sintTermo(tToken*);
+tControle sintTermo(tToken*, tExpressao*);
 tControle sintVariaveis(tToken*);
 
 /*Implementacoes sem ordem*/
 /**
- * @brief Escreve mensagem de erro no arquivo
+ * @brief Relata uma mensagem de erro
  *
- * Eh responsavel por relatar o erro no arquivo.
+ * Eh responsavel por relatar o erro, guardando-o nos diagnosticos com a linha e
+ *  a coluna do token atual. Depois de atingido o limite de erros nada eh relatado.
  *
- * @param mensagem const char* : mensagem que sera escrita no arquivo
+ * @param mensagem const char* : mensagem do erro
  */
 void mensagemErro(const char *mensagem) {
 
-	++contErros;
-	fprintf(stdout, "Linha %05u: %s\n", getLinhaAtual(), mensagem);
+	if (registrarDiagnostico(mensagem, getLinhaAtual(), getColunaAtual()) == SUCESSO)
+		++contErros;
+}
+
+/**
+ * @brief Confere o limite de memoria
+ *
+ * Ao passar do limite relata o erro e interrompe a analise, que termina pelo
+ *  mesmo caminho do limite de erros. Chamada depois da analise lexica e ao fim
+ *  de cada procedimento, quando o escopo local ja foi descartado.
+ */
+void sintConferirMemoria(void) {
+
+	if (conferirMemoria() != SUCESSO && !limiteDeErrosAtingido()) {
+		mensagemErro("Limite de memoria excedido.");
+		interromperAnalise();
+	}
 }
 
 /**
@@ -77,30 +119,25 @@ void mensagemErro(const char *mensagem) {
  *  chamada quando acontece um erro sintatico, ou seja, sempre que obtiver um token que nao era esperado
  *  para aquela situacao.
  *
+ * O conjunto de sincronizadores eh um mapa de bits sobre os codigos dos tokens,
+ *  assim verificar se um token sincroniza custa apenas um E bit a bit.
+ *
  * @param token tToken* : token de entrada e que sera sincronizado
- * @param sincronizadores const unsigned short int* : vetor de sincronizadores
- * @param tamnho const unsigned short int : tamanho do vetor
+ * @param sincronizadores const tConjuntoTokens : conjunto de sincronizadores
  *
  * @return tControle : retorna um relato do erro ou FIM_ARQ_PREMATURO
  */
-tControle modoPanico(tToken *token, const unsigned short int *sincronizadores,
-		const unsigned short int tamanho) {
+tControle modoPanico(tToken *token, const tConjuntoTokens sincronizadores) {
 
 	auto signed char achouSincronizador = 0;
-	register unsigned short int i;
 
 	do {
 		if (token->signo == COMENTARIO_ERRO) {
 
 			mensagemErro("Comentario nao fechado.");
 			return FIM_ARQ_PREMATURO;
-		} else {
-			for (i = 0; i < tamanho; ++i)
-				if (token->signo == sincronizadores[i]) {
-					achouSincronizador = 1;
-					break;
-				}
-		}
+		} else if (PERTENCE(token->signo, sincronizadores))
+			achouSincronizador = 1;
 
 		if (!achouSincronizador && getToken(token) != SUCESSO)
 			return FIM_ARQ_PREMATURO;
@@ -124,27 +161,40 @@ tControle modoPanico(tToken *token, const unsigned short int *sincronizadores,
  *
  * @param token tToken * : recebe o primeiro token e retorna o token apos a
  * analise.
+ * @param saida tExpressao* : recebe a arvore da expressao.
  *
  * @return SUCESSO ou codigo de erro.
  */
-tControle sintExpressao(tToken *token) {
+tControle sintExpressao(tToken *token, tExpressao *saida) {
+
+	auto tToken sinal;
+	auto tControle erro;
+
+	*saida = NULL;
+	sinal.signo = 0;
 
 	/*Verifica se o token capturado foi o + ou o - */
-	if (token->signo == MAIS || token->signo == MENOS)
+	if (token->signo == MAIS || token->signo == MENOS) {
+		sinal = *token;
 		if (getToken(token) != SUCESSO)
 			return FIM_ARQ_PREMATURO;
+	}
 
-	auto tControle erro = sintFator(token);
+	erro = sintFator(token, saida);
 
 	if (erro == SUCESSO)
-		erro = sintMaisFator(token);
+		erro = sintMaisFator(token, saida);
 	else
-		sintMaisFator(token);
+		sintMaisFator(token, saida);
+
+	/*o sinal vale para o primeiro termo*/
+	if (sinal.signo)
+		*saida = criarExpressao(&sinal, *saida, NULL);
 
 	if (erro == SUCESSO)
-		erro = sintOutrosTermos(token);
+		erro = sintOutrosTermos(token, saida);
 	else
-		sintOutrosTermos(token);
+		sintOutrosTermos(token, saida);
 
 	return erro;
 }
@@ -157,36 +207,36 @@ tControle sintExpressao(tToken *token) {
  *
  * @param token tToken* : recebe o primeiro token e retorna outro token
  *  apos a saida.
+ * @param saida tExpressao* : recebe o operando esquerdo e retorna a arvore
+ *  com os termos seguintes, associados a esquerda.
  *
  * @return tControle para quando ocorrer algum erro.
  */
-tControle sintOutrosTermos(tToken *token) {
-
-	auto tControle erro = SUCESSO;
+tControle sintOutrosTermos(tToken *token, tExpressao *saida) {
 
-	if (token->signo == MAIS || token->signo == MENOS) {
-
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+	auto tControle erro = SUCESSO, termo;
+	auto tToken operador;
+	auto tExpressao direita;
 
-		if (getToken(token) == SUCESSO) {
+	/*um termo por volta, a arvore cresce pela esquerda*/
+	while (token->signo == MAIS || token->signo == MENOS) {
 
-			erro = sintTermo(token);
+		operador = *token;
 
-			if (erro == SUCESSO)
-				return sintOutrosTermos(token);
-			else {
+		if (getToken(token) != SUCESSO)
+			return FIM_ARQ_PREMATURO;
 
-				sintOutrosTermos(token);
+		termo = sintTermo(token, &direita);
 
-				return erro;
-			}
+		/*representacao intermediaria*/
+		*saida = criarExpressao(&operador, *saida, direita);
 
-		} else
-			return FIM_ARQ_PREMATURO;
+		/*o primeiro erro eh propagado*/
+		if (erro == SUCESSO)
+			erro = termo;
 	}
-	else
-		return erro;
+
+	return erro;
 }
 
 /**
@@ -194,7 +244,7 @@ tControle sintOutrosTermos(tToken *token) {
  *
  * Esta funcao eh composta por um switch que identificara qual dos possiveis
  *  primeiros de fator estamos analisando. Se for identificador, inteiro ou
- *  real ent�o eh getToken e retornado seu valor; se for abre parenteses eh
+ *  real ento eh getToken e retornado seu valor; se for abre parenteses eh
  *  feito um getToken e chamado sintExpressao, depois espera-se fecha parenteses
  *  caso esta sequencia esteje certa eh retornado o valor de retorno do
  *  sintExpressao, senao eh chamado o modo panico para tratar. Como esta funcao
@@ -204,45 +254,43 @@ tControle sintOutrosTermos(tToken *token) {
  * @see sintFator()
  *
  * @param token tToken* : recebe o primeiro token e retorna o proximo
+ * @param saida tExpressao* : recebe a folha ou o agrupamento do fator.
  *
  * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
  */
-tControle sintFator(tToken *token) {
+tControle sintFator(tToken *token, tExpressao *saida) {
 
 	auto tControle erro = SUCESSO;
+	auto tToken agrupamento;
+	auto tExpressao interna;
+
+	*saida = NULL;
 
 	switch (token->signo) {
 
 	case IDENTIFICADOR:
 		/*codigo do analisador semantico*/
-		semVerDeclVar(*token);
+		RASTREAR("semVerDeclVar", "semantico", semVerDeclVar(token));
 
 	case NUMERO_INTEIRO:
 	case NUMERO_REAL:
 
-		/*codigo do gerador*/
-		gecConverteReal(token);
-
-		/*codigo do analisador semantico*/
-		semEmpilhaTemp(*token);
-
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+		/*representacao intermediaria*/
+		*saida = criarExpressao(token, NULL, NULL);
 
 		return getToken(token);
 
 	case ABRE_PARENTESES:
 
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+		agrupamento = *token;
 
 		if (getToken(token) == SUCESSO)
-			erro = sintExpressao(token);
+			erro = sintExpressao(token, &interna);
 		else
 			return FIM_ARQ_PREMATURO;
 
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+		/*representacao intermediaria*/
+		*saida = criarExpressao(&agrupamento, interna, NULL);
 
 		if (token->signo == FECHA_PARENTESES)
 			if (getToken(token) == SUCESSO)
@@ -258,9 +306,7 @@ tControle sintFator(tToken *token) {
 	}
 
 	/*seguidores de fator*/
-	const unsigned short int sincronizadores[] = { ASTERISCO, BARRA, MAIS,
-			MENOS, FIM, ABRE_PARENTESES, ENTAO };
-	return modoPanico(token, sincronizadores, 7);
+	return modoPanico(token, SINC_SEGUIDORES_FATOR);
 
 }
 
@@ -268,36 +314,38 @@ tControle sintFator(tToken *token) {
  * @brief Implementa o grafo de MaisFator.
  *
  * Se for encontrado um asterisco ou barra entao busca-se outro token e a execucao
- *  prossegue a partir de sintFator e uma chamada recursiva para ele mesmo
+ *  prossegue a partir de sintFator, repetindo enquanto houver asterisco ou barra
  *
  * @see sintFator()
  *
  * @param token tToken* : recebe o primeiro token e retorna o proximo
+ * @param saida tExpressao* : recebe o operando esquerdo e retorna a arvore
+ *  com os fatores seguintes, associados a esquerda.
  *
  * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
  */
-tControle sintMaisFator(tToken *token) {
+tControle sintMaisFator(tToken *token, tExpressao *saida) {
 
-	if (token->signo == ASTERISCO || token->signo == BARRA) {
+	auto tToken operador;
+	auto tExpressao direita;
+	auto tControle erro = SUCESSO;
 
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+	/*um fator por volta, a arvore cresce pela esquerda*/
+	while (token->signo == ASTERISCO || token->signo == BARRA) {
 
-		if (getToken(token) == SUCESSO) {
+		operador = *token;
 
-			if (sintFator(token) == SUCESSO)
-				return sintMaisFator(token);
-			else {
+		if (getToken(token) != SUCESSO)
+			return FIM_ARQ_PREMATURO;
 
-				sintMaisFator(token);
+		if (sintFator(token, &direita) != SUCESSO)
+			erro = ERRO;
 
-				return ERRO;
-			}
-		} else
-			return FIM_ARQ_PREMATURO;
+		/*representacao intermediaria*/
+		*saida = criarExpressao(&operador, *saida, direita);
 	}
-	else
-		return SUCESSO;
+
+	return erro;
 }
 
 /**
@@ -311,16 +359,22 @@ tControle sintMaisFator(tToken *token) {
  * @see sintMaisFator()
  *
  * @param token tToken* : recebe o primeiro token e retorna o proximo
+ * @param saida tExpressao* : recebe a arvore do termo.
  *
  * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
  */
-tControle sintTermo(tToken *token) {
+tControle sintTermo(tToken *token, tExpressao *saida) {
+
+	auto tToken sinal;
+	auto tControle erro = SUCESSO;
+
+	*saida = NULL;
+	sinal.signo = 0;
 
 	/*pode ou nao comecar com '+' / '-'*/
 	if (token->signo == MAIS || token->signo == MENOS) {
 
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+		sinal = *token;
 
 		if (getToken(token) != SUCESSO)
 			return FIM_ARQ_PREMATURO;
@@ -328,14 +382,20 @@ tControle sintTermo(tToken *token) {
 
 	/*se nao ocorreu erro em sintFator
 	 * o valor dependera do sintMaisFator*/
-	if (sintFator(token) == SUCESSO)
-		return sintMaisFator(token);
+	if (sintFator(token, saida) == SUCESSO)
+		erro = sintMaisFator(token, saida);
 	else {
 
-		sintMaisFator(token);
+		sintMaisFator(token, saida);
 
-		return ERRO;
+		erro = ERRO;
 	}
+
+	/*representacao intermediaria*/
+	if (sinal.signo)
+		*saida = criarExpressao(&sinal, *saida, NULL);
+
+	return erro;
 }
 
 /**
@@ -345,6 +405,7 @@ tControle sintTermo(tToken *token) {
  *  temos um condicional, se nao estamos em situacao de erro e o modo panico eh chamado.
  *  Depois chama-se sintExpressao novamente, o valor de retorno dependera das funcoes
  *  chamadas e da existencia do condicional entre as exprecoes.
+ * As duas expressoes sao tipadas e, se uma for real, a outra eh convertida.
  *
  * @see sintExpressao()
  *
@@ -354,53 +415,69 @@ tControle sintTermo(tToken *token) {
  */
 tControle sintCondicao(tToken *token) {
 
-	auto tControle erro = sintExpressao(token);
+	auto tExpressao esquerda, direita;
+	auto char *relacao;
+	auto signed char tipo;
+	auto tControle erro = sintExpressao(token, &esquerda);
 
 	switch (token->signo) {
 
 	case IGUAL:
-		/*codigo do gerador*/
-		gecGeraCodigo(" == ");
+		relacao = " == ";
 		break;
 	case DIFERENTE:
-		/*codigo do gerador*/
-		gecGeraCodigo(" != ");
+		relacao = " != ";
 		break;
 	case MENOR_IGUAL:
 	case MAIOR_IGUAL:
 	case MAIOR:
 	case MENOR:
-		/*codigo do gerador*/
-		gecGeraCodigo(token->cadeia);
+		relacao = token->cadeia;
 		break;
 	default:
 		mensagemErro("Esperava-se algum condicional.");
 
-		const unsigned short int sicronizadores[] = { MAIS, MENOS,
-				IDENTIFICADOR, NUMERO_INTEIRO, NUMERO_REAL, ABRE_PARENTESES,
-				FIM };
-		modoPanico(token, sicronizadores, 7);
+		modoPanico(token, SINC_PRIMEIROS_EXPRESSAO | CONJ(FIM));
 
 		/*jah ocorreu um erro entrou em modo panico entao o valor de
 		 * sintExpressao nao tem serventia*/
-		sintExpressao(token);
+		sintExpressao(token, &direita);
+
+		destruirExpressao(&esquerda);
+		destruirExpressao(&direita);
 		return ERRO;
 	}
 
 	/*continuacao a partir de algum sinal de desigualdade*/
-	if (getToken(token) != SUCESSO)
+	if (getToken(token) != SUCESSO) {
+		destruirExpressao(&esquerda);
 		return FIM_ARQ_PREMATURO;
+	}
 
 	/*se obteve sucesso o valor dependera da chamada anterior
 	 * caso contrario eh uma situacao de erro*/
 	if (erro == ERRO)
-		sintExpressao(token);
+		sintExpressao(token, &direita);
 	else
-		erro = sintExpressao(token);
+		erro = sintExpressao(token, &direita);
 
 	/*codigo do analisador semantico*/
+	tipo = RASTREAR("semTiparExpressao", "semantico", semTiparExpressao(esquerda));
+	if (RASTREAR("semTiparExpressao", "semantico", semTiparExpressao(direita)) == REAL)
+		tipo = REAL;
 	semApagaTemp();
 
+	/*numeracao de valores*/
+	otmCondicao(esquerda, direita);
+
+	/*codigo do gerador*/
+	gecExpressao(esquerda, tipo);
+	gecGeraCodigo(relacao);
+	gecExpressao(direita, tipo);
+
+	destruirExpressao(&esquerda);
+	destruirExpressao(&direita);
+
 	return erro;
 }
 
@@ -418,41 +495,40 @@ tControle sintCondicao(tToken *token) {
  */
 tControle sintComando(tToken *token) {
 
-	auto tControle erro;
+	auto tControle erro = SUCESSO;
 
-	switch (token->signo) {
-	/*primeiros de cmd*/
-	case LE:
-	case ESCREVE:
-	case ENQUANTO:
-	case SE:
-	case IDENTIFICADOR:
-	case INICIO:
+	/*um cmd por volta, assim o numero de comandos nao depende da pilha*/
+	for (;;)
+		switch (token->signo) {
+		/*primeiros de cmd*/
+		case LE:
+		case ESCREVE:
+		case ENQUANTO:
+		case SE:
+		case IDENTIFICADOR:
+		case INICIO:
 
-		erro = sintCmd(token);
+			if (sintCmd(token) != SUCESSO)
+				erro = ERRO;
 
-		/*verifica terminador de cmd*/
-		if (token->signo == PONTO_E_VIRGULA) {
+			/*verifica terminador de cmd*/
+			if (token->signo != PONTO_E_VIRGULA) {
 
-			if (getToken(token) != SUCESSO)
-				return FIM_ARQ_PREMATURO;
-			else
-				return sintComando(token) == SUCESSO ? erro : ERRO;
-		}
-		else {
+				mensagemErro("Esperava-se ponto-e-virgula.");
 
-			mensagemErro("Esperava-se ponto-e-virgula.");
+				modoPanico(token, SINC_PRIMEIROS_CMD | CONJ(FIM));
 
-			const unsigned short int sincronizadores[] = { LE, ESCREVE,
-					ENQUANTO, SE, IDENTIFICADOR, INICIO, FIM };
-			modoPanico(token, sincronizadores, 7);
+				return ERRO;
+			}
 
-			return ERRO;
+			if (getToken(token) != SUCESSO)
+				return FIM_ARQ_PREMATURO;
+
+			break;
+			/*caso nao primeiro de cmd*/
+		default:
+			return erro;
 		}
-		/*caso nao primeiro de cmd*/
-	default:
-		return SUCESSO;
-	}
 }
 
 /**
@@ -476,11 +552,15 @@ tControle sintListaArg(tToken *token) {
 		while ((getToken(token) == SUCESSO) && (token->signo == IDENTIFICADOR)) {
 
 			/*codigo do analisador semantico*/
-			semVerDeclVar(*token);
-			semEmpilhaTemp(*token);
+			RASTREAR("semVerDeclVar", "semantico", semVerDeclVar(token));
+			semArgumento(token);
+
+			/*sem memoria para o argumento a chamada fica em C*/
+			if (expArgumento(token->cadeia) != SUCESSO)
+				expDesistir();
 
 			/*gerador de codigo*/
-			gecGeraCodigo(token->cadeia);
+			gecIdentificador(token->cadeia);
 
 			if (getToken(token) != SUCESSO)
 				return FIM_ARQ_PREMATURO;
@@ -501,8 +581,7 @@ tControle sintListaArg(tToken *token) {
 
 			mensagemErro("Esperava-se fecha parenteses.");
 
-			const unsigned short int sincronizadores[] = { PONTO_E_VIRGULA };
-			modoPanico(token, sincronizadores, 1);
+			modoPanico(token, CONJ(PONTO_E_VIRGULA));
 
 			/*faltou falar do ponto de virgula,
 			 * tambem pode estar faltando ele na
@@ -531,6 +610,12 @@ tControle sintCorpoPrograma(tToken *token) {
 
 	auto tControle controle = sintDeclaracaoVariaveis(token);
 
+	/*numeracao de valores, cada corpo eh uma funcao ou bloco proprio*/
+	otmReiniciar();
+
+	/*codigo do gerador*/
+	gecInicioCorpo();
+
 	if (token->signo == INICIO)
 		if (getToken(token) != SUCESSO)
 			return FIM_ARQ_PREMATURO;
@@ -540,9 +625,7 @@ tControle sintCorpoPrograma(tToken *token) {
 
 		mensagemErro("Esperava-se inicio.");
 
-		const unsigned short int sincronizadores[] = { LE, ESCREVE, ENQUANTO,
-				SE, IDENTIFICADOR, INICIO };
-		controle = modoPanico(token, sincronizadores, 6);
+		controle = modoPanico(token, SINC_PRIMEIROS_CMD);
 	}
 
 	/*se jah houve erro este deve ser propagado*/
@@ -569,8 +652,29 @@ tControle sintCorpoPrograma(tToken *token) {
 		mensagemErro("Esperava-se fim.");
 
 	/*situacao de erro, se chegou aqui nao houve sucesso*/
-	const unsigned short int sicronizadores[] = { PROCEDIMENTO, INICIO };
-	return modoPanico(token, sicronizadores, 2);
+	return modoPanico(token, CONJ(PROCEDIMENTO) | CONJ(INICIO));
+}
+
+/**
+ * @brief Analisa o corpo de um procedimento expandido
+ *
+ * Usado pela expansao em linha com os parametros ja no escopo local. O corpo
+ *  eh analisado como o de um procedimento, no escopo local.
+ *
+ * @param token tToken* : recebe o primeiro token do corpo e retorna o proximo
+ *
+ * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
+ */
+tControle sintCorpoExpandido(tToken *token) {
+
+	auto unsigned int escopoAnterior = escopo;
+	auto tControle erro;
+
+	escopo = 1;
+	erro = sintCorpoPrograma(token);
+	escopo = escopoAnterior;
+
+	return erro;
 }
 
 /**
@@ -595,16 +699,14 @@ tControle sintVariaveis(tToken *token) {
 		if (token->signo == IDENTIFICADOR) {
 
 			/*codigo do analisador semantico*/
-			semEmpilhaTemp(*token);
+			semEmpilhaTemp(token);
 
 			if (getToken(token) != SUCESSO)
 				return FIM_ARQ_PREMATURO;
 		} else {
 			mensagemErro("Esperava-se identificador.");
 
-			const unsigned short int sincronizadores[] = { DOIS_PONTOS, REAL,
-					INTEIRO, FECHA_PARENTESES };
-			return modoPanico(token, sincronizadores, 4);
+			return modoPanico(token, SINC_TIPO | CONJ(DOIS_PONTOS) | CONJ(FECHA_PARENTESES));
 		}
 
 		if (token->signo == VIRGULA) {
@@ -620,9 +722,7 @@ tControle sintVariaveis(tToken *token) {
 	else {
 		mensagemErro("Esperava-se identificador.");
 
-		const unsigned short int sincronizadores[] = { DOIS_PONTOS, REAL,
-				INTEIRO };
-		return modoPanico(token, sincronizadores, 3);
+		return modoPanico(token, SINC_TIPO | CONJ(DOIS_PONTOS));
 	}
 }
 
@@ -652,15 +752,14 @@ tControle sintListaParametro(tToken *token) {
 			;
 	else {
 		mensagemErro("Esperava-se dois-pontos.");
-		const unsigned short int sincronizador[] = { REAL, INTEIRO,
-				PONTO_E_VIRGULA, FECHA_PARENTESES };
-		erro = modoPanico(token, sincronizador, 4);
+		erro = modoPanico(token, SINC_TIPO | CONJ(PONTO_E_VIRGULA)
+				| CONJ(FECHA_PARENTESES));
 	}
 
 	if (token->signo == REAL || token->signo == INTEIRO) {
 
 		/*codigo do gerador*/
-		gecDecArg(*token);
+		gecDecArg(token);
 
 		/*codigo do analisador semantico*/
 		semDeclareVariaveis(escopo, token->signo);
@@ -669,9 +768,7 @@ tControle sintListaParametro(tToken *token) {
 			return FIM_ARQ_PREMATURO;
 	} else {
 		mensagemErro("Esperava-se real ou inteiro.");
-		const unsigned short int sincronizador[] = { PONTO_E_VIRGULA,
-				FECHA_PARENTESES };
-		erro = modoPanico(token, sincronizador, 2);
+		erro = modoPanico(token, CONJ(PONTO_E_VIRGULA) | CONJ(FECHA_PARENTESES));
 	}
 
 	if (token->signo == PONTO_E_VIRGULA) {
@@ -687,47 +784,45 @@ tControle sintListaParametro(tToken *token) {
 	else
 		return erro;
 }
-
 /**
- * @brief Implementa grafo dc_p
+ * @brief Implementa o cabecalho de um procedimento
  *
- * Verifica se comeca o token procedimento, se nao passara diretamente,
- *  ou seja, considera como procedimento inexistente. Depois se para a declaracao
- *  de parametros e variavaveis, por ultimo trata o corpo do programa.
+ * Trata o nome e a lista de parametros de um procedimento, ate o ponto-e-virgula,
+ *  e o declara no escopo global. Os parametros ficam no escopo local.
  *
- * @param token tToken* : recebe o primeiro token e retorna o proximo
+ * @param token tToken* : recebe o token procedimento e retorna o proximo
+ * @param nomeProcedimento char** : recebe o nome do procedimento
  *
  * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
  */
-tControle sintDeclaracaoProcedimentos(tToken *token) {
+tControle sintCabecalhoProcedimento(tToken *token, char **nomeProcedimento) {
 
-	/*testa para ver se existe procedimento*/
-	if (token->signo != PROCEDIMENTO)
-		return SUCESSO;
-	else if (getToken(token) != SUCESSO)
+	auto tControle erro = SUCESSO;
+	auto unsigned int inicio = getIndiceToken() - 1;
+
+	*nomeProcedimento = "";
+
+	if (getToken(token) != SUCESSO)
 		return FIM_ARQ_PREMATURO;
 
 	/*codigo do gerador*/
-	gecGeraCodigo("\nvoid ");
+	gecLinha(token->linha, getColunaAtual());
+	gecCabecalhoProcedimento(token->cadeia, expSeraExpansivel(inicio));
 
 	/*se procedimento existir a compilacao continua*/
 	escopo = 1;
-	auto tControle erro = SUCESSO;
-	auto char nomeProcedimento[256];
 
 	/*codigo do gerador*/
 	gecGeraCodigo(token->cadeia);
 
 	/*nome do procedimento*/
 	if (token->signo == IDENTIFICADOR) {
-		strcpy(nomeProcedimento, token->cadeia);
+		*nomeProcedimento = token->cadeia;
 		if (getToken(token) != SUCESSO)
 			return FIM_ARQ_PREMATURO;
 	} else {
 		mensagemErro("Esperava-se identificador.");
-		const unsigned short int sincronizador[] = { ABRE_PARENTESES,
-				PONTO_E_VIRGULA };
-		erro = modoPanico(token, sincronizador, 2);
+		erro = modoPanico(token, CONJ(ABRE_PARENTESES) | CONJ(PONTO_E_VIRGULA));
 	}
 
 	/*codigo do gerador*/
@@ -747,8 +842,7 @@ tControle sintDeclaracaoProcedimentos(tToken *token) {
 				;
 		else {
 			mensagemErro("Esperava-se fecha parenteses.");
-			const unsigned short int sincronizador[] = { PONTO_E_VIRGULA };
-			erro = modoPanico(token, sincronizador, 1);
+			erro = modoPanico(token, CONJ(PONTO_E_VIRGULA));
 		}
 	}
 
@@ -763,13 +857,66 @@ tControle sintDeclaracaoProcedimentos(tToken *token) {
 			;
 	else {
 		mensagemErro("Esperava-se ponto-e-virgula.");
-		const unsigned short int
-				sincronizador[] = { VAR, INICIO, PROCEDIMENTO };
-		erro = modoPanico(token, sincronizador, 3);
+		erro = modoPanico(token, SINC_DECLARACOES);
 	}
 
 	/*codigo do analisador semantico*/
-	semDeclareProcedimento(nomeProcedimento);
+	semDeclareProcedimento(*nomeProcedimento);
+
+	return erro;
+}
+
+/**
+ * @brief Declara a assinatura de um procedimento sem compila-lo
+ *
+ * Trata apenas o cabecalho, sem gerar codigo, e descarta o escopo local. Usado
+ *  pela compilacao paralela para conhecer os procedimentos compilados por outro
+ *  processo; o corpo deve ser pulado por quem chama.
+ *
+ * @param token tToken* : recebe o token procedimento e retorna o proximo
+ *
+ * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
+ */
+tControle sintAssinaturaProcedimento(tToken *token) {
+
+	auto tControle erro;
+	auto char *nomeProcedimento;
+
+	gecSuspender(1);
+	erro = sintCabecalhoProcedimento(token, &nomeProcedimento);
+	gecSuspender(0);
+
+	escopo = 0;
+	semLimpaLocal();
+
+	return erro;
+}
+
+/**
+ * @brief Implementa um procedimento de dc_p
+ *
+ * Trata o cabecalho, depois a declaracao de variaveis e o corpo do procedimento,
+ *  e por fim descarta o escopo local.
+ *
+ * @param token tToken* : recebe o token procedimento e retorna o proximo
+ *
+ * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
+ */
+tControle sintProcedimento(tToken *token) {
+
+	auto tControle erro;
+	auto char *nomeProcedimento;
+	auto unsigned int inicio = getIndiceToken() - 1;
+
+	rastroInicio("procedimento", "sintatico");
+
+	/*codigo da compilacao incremental*/
+	incInicioProcedimento();
+
+	if ((erro = sintCabecalhoProcedimento(token, &nomeProcedimento)) == FIM_ARQ_PREMATURO) {
+		rastroFim(NULL);
+		return erro;
+	}
 
 	if (sintCorpoPrograma(token) != SUCESSO)
 		erro = ERRO;
@@ -777,11 +924,55 @@ tControle sintDeclaracaoProcedimentos(tToken *token) {
 	/*codigo do analisador semantico*/
 	escopo = 0;
 	semLimpaLocal();
+	sintConferirMemoria();
 
 	/*codigo do gerador*/
 	gecGeraCodigo("\n}\n");
+	gecFimDeclaracao();
+
+	/*codigo da compilacao incremental*/
+	incFimProcedimento(nomeProcedimento);
+
+	/*as proximas chamadas podem expandir o procedimento*/
+	expRegistrar(inicio, getIndiceToken() - 1);
+
+	rastroFim(nomeProcedimento);
+
+	return erro;
+}
+
+/**
+ * @brief Implementa grafo dc_p
+ *
+ * Verifica se comeca o token procedimento, se nao passara diretamente,
+ *  ou seja, considera como procedimento inexistente. Cada procedimento eh
+ *  reaproveitado da compilacao anterior ou compilado por sintProcedimento, em
+ *  um laco, assim o numero de procedimentos nao depende do tamanho da pilha.
+ *
+ * @param token tToken* : recebe o primeiro token e retorna o proximo
+ *
+ * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
+ */
+tControle sintDeclaracaoProcedimentos(tToken *token) {
+
+	auto tControle erro = SUCESSO, resultado;
 
-	return sintDeclaracaoProcedimentos(token) == SUCESSO ? erro : ERRO;
+	/*um procedimento por volta, enquanto houver procedimento*/
+	while (token->signo == PROCEDIMENTO) {
+
+		/*procedimento inalterado desde a compilacao anterior*/
+		if ((resultado = incReaproveitar(token)) == SUCESSO)
+			continue;
+		else if (resultado == FIM_ARQ_PREMATURO)
+			return FIM_ARQ_PREMATURO;
+
+		if ((resultado = sintProcedimento(token)) == FIM_ARQ_PREMATURO)
+			return FIM_ARQ_PREMATURO;
+		else if (resultado != SUCESSO)
+			erro = ERRO;
+	}
+
+	return erro;
 }
 
 /**
@@ -799,7 +990,7 @@ tControle sintDeclaracaoProcedimentos(tToken *token) {
  */
 tControle sintDeclaracaoVariaveis(tToken *token) {
 
-	auto tControle erro = SUCESSO;
+	auto tControle erro = SUCESSO, lista;
 
 	/*se encontrar um var*/
 	if (token->signo == VAR)
@@ -817,8 +1008,11 @@ tControle sintDeclaracaoVariaveis(tToken *token) {
 	}
 
 	/*continua a compilacao caso nao tenha encontrado var
-	 * ou identificador*/
-	if (sintVariaveis(token))
+	 * ou identificador; no fim do arquivo o token nao muda mais e a
+	 * chamada recursiva do final nunca pararia*/
+	if ((lista = sintVariaveis(token)) == FIM_ARQ_PREMATURO)
+		return FIM_ARQ_PREMATURO;
+	else if (lista)
 		erro = ERRO;
 
 	if (token->signo == DOIS_PONTOS)
@@ -830,14 +1024,14 @@ tControle sintDeclaracaoVariaveis(tToken *token) {
 
 		mensagemErro("Esperava-se dois pontos.");
 
-		const unsigned short int sincronizador[] = { REAL, INTEIRO,
-				PONTO_E_VIRGULA, FECHA_PARENTESES };
-		erro = modoPanico(token, sincronizador, 4);
+		if ((erro = modoPanico(token, SINC_TIPO | CONJ(PONTO_E_VIRGULA)
+				| CONJ(FECHA_PARENTESES))) == FIM_ARQ_PREMATURO)
+			return FIM_ARQ_PREMATURO;
 	}
 
 	if (token->signo == REAL || token->signo == INTEIRO) {
 		/* codigo do gerador */
-		gecDecVar(*token);
+		gecDecVar(token, escopo);
 
 		/*codigo do analisador semantico*/
 		semDeclareVariaveis(escopo, token->signo);
@@ -851,9 +1045,9 @@ tControle sintDeclaracaoVariaveis(tToken *token) {
 
 		mensagemErro("Esperava-se inteiro ou real.");
 
-		const unsigned short int sincronizador[] = { PONTO_E_VIRGULA,
-				FECHA_PARENTESES, PROCEDIMENTO, INICIO };
-		erro = modoPanico(token, sincronizador, 4);
+		if ((erro = modoPanico(token, CONJ(PONTO_E_VIRGULA) | CONJ(FECHA_PARENTESES)
+				| CONJ(PROCEDIMENTO) | CONJ(INICIO))) == FIM_ARQ_PREMATURO)
+			return FIM_ARQ_PREMATURO;
 	}
 
 	if (token->signo == PONTO_E_VIRGULA)
@@ -865,9 +1059,8 @@ tControle sintDeclaracaoVariaveis(tToken *token) {
 
 		mensagemErro("Esperava-se ponto e virgula.");
 
-		const unsigned short int sincronizadores[] = { VAR, PROCEDIMENTO,
-				INICIO };
-		erro = modoPanico(token, sincronizadores, 3);
+		if ((erro = modoPanico(token, SINC_DECLARACOES)) == FIM_ARQ_PREMATURO)
+			return FIM_ARQ_PREMATURO;
 	}
 
 	if (erro == SUCESSO)
@@ -891,6 +1084,16 @@ tControle sintCmd(tToken *token) {
 
 	auto tControle erro = SUCESSO;
 	auto char leEscreve = 1; /*verifica se eh le ou escreve*/
+	auto tToken ident; /*identificador que inicia atribuicao ou chamada*/
+	auto tExpressao expressao; /*lado direito da atribuicao*/
+	auto signed char tipo; /*tipo da variavel atribuida*/
+	auto signed char expandir; /*chamada expandida em linha*/
+	auto unsigned int valor; /*numero do valor atribuido*/
+	auto tEstadoValores *estado, *ramo; /*numeracao de valores antes e depois do primeiro ramo do se*/
+	auto unsigned int linha = token->linha, coluna = getColunaAtual(); /*posicao do comando*/
+
+	/*gerador de codigo*/
+	gecLinha(linha, coluna);
 
 	switch (token->signo) {
 	/*para ler e escrever*/
@@ -908,9 +1111,7 @@ tControle sintCmd(tToken *token) {
 
 			mensagemErro("Esperava-se abre parenteses.");
 
-			const unsigned short int sincro[] = { IDENTIFICADOR,
-					FECHA_PARENTESES };
-			erro = modoPanico(token, sincro, 1);
+			erro = modoPanico(token, CONJ(IDENTIFICADOR) | CONJ(FECHA_PARENTESES));
 		}
 
 		if (sintVariaveis(token) != SUCESSO)
@@ -921,8 +1122,12 @@ tControle sintCmd(tToken *token) {
 		/*gerador de codigo*/
 		gecAddPontoVirgula();
 
+		/*numeracao de valores*/
+		if (leEscreve)
+			otmLeitura();
+
 		/*codigo do analisador semantico*/
-		semVerLeEscreve();
+		RASTREAR("semVerLeEscreve", "semantico", semVerLeEscreve());
 		semApagaTemp();
 
 		if (token->signo == FECHA_PARENTESES)
@@ -932,8 +1137,7 @@ tControle sintCmd(tToken *token) {
 				return FIM_ARQ_PREMATURO;
 		else {
 			mensagemErro("Esperava-se fecha parenteses.");
-			const unsigned short int sincro[] = { PONTO_E_VIRGULA, FIM, SENAO };
-			erro = modoPanico(token, sincro, 3);
+			erro = modoPanico(token, SINC_FIM_CMD);
 		}
 		break;
 
@@ -944,24 +1148,31 @@ tControle sintCmd(tToken *token) {
 
 		/*codigo do gerador*/
 		gecGeraCodigo("\nwhile( ");
+		gecInicioCondicao("enquanto", linha, coluna);
+
+		/*numeracao de valores, o corpo pode repetir*/
+		otmReiniciar();
 
 		erro = sintCondicao(token);
 
 		/*codigo do gerador*/
+		gecFimCondicao();
 		gecGeraCodigo(")");
 
 		if (token->signo == FACA)
-			if (getToken(token) == SUCESSO)
-				return sintCmd(token);
+			if (getToken(token) == SUCESSO) {
+				erro = sintCmd(token);
+				otmReiniciar();
+				return erro;
+			}
 			else
 				return FIM_ARQ_PREMATURO;
 		else {
 			mensagemErro("Esperava-se faca.");
-			const unsigned short int sincro[] = { LE, ESCREVE, ENQUANTO, SE,
-					IDENTIFICADOR, INICIO };
-			erro = modoPanico(token, sincro, 6);
+			erro = modoPanico(token, SINC_PRIMEIROS_CMD);
 		}
 		sintCmd(token);
+		otmReiniciar();
 
 		/*gerador de codigo*/
 		gecAddPontoVirgula();
@@ -975,12 +1186,14 @@ tControle sintCmd(tToken *token) {
 
 		/*codigo do gerador*/
 		gecGeraCodigo("\nif( ");
+		gecInicioCondicao("se", linha, coluna);
 
 		/*chamando sintCondicao*/
 		if (sintCondicao(token) != SUCESSO)
 			erro = sintCondicao(token);
 
 		/*codigo do gerador*/
+		gecFimCondicao();
 		gecGeraCodigo(") ");
 
 		/*reconhecendo entao*/
@@ -992,11 +1205,12 @@ tControle sintCmd(tToken *token) {
 		else {
 			mensagemErro("Esperava-se entao.");
 
-			const unsigned short int sincro[] = { ESCREVE, LE, ENQUANTO, SE,
-					IDENTIFICADOR, INICIO };
-			erro = modoPanico(token, sincro, 6);
+			erro = modoPanico(token, SINC_PRIMEIROS_CMD);
 		}
 
+		/*numeracao de valores, os ramos partem do estado apos a condicao*/
+		estado = otmSalvar();
+
 		/*chamando sintCmd*/
 		if (erro == SUCESSO)
 			erro = sintCmd(token);
@@ -1004,29 +1218,39 @@ tControle sintCmd(tToken *token) {
 			sintCmd(token);
 
 		/*fim enquatrar fim ou senao*/
-		if (token->signo == FIM)
+		if (token->signo == FIM) {
+
+			otmJuntar(estado, NULL, 0);
+
 			if (getToken(token) == SUCESSO)
 				return erro;
 			else
 				return FIM_ARQ_PREMATURO;
+		}
 		else if (token->signo == SENAO) {
 
+			ramo = otmSalvar();
+			otmRestaurar(estado);
+
 			/*gerador de codigo*/
 			gecGeraCodigo("\nelse");
 
-			if (getToken(token) != SUCESSO)
+			if (getToken(token) != SUCESSO) {
+				otmJuntar(estado, ramo, 1);
 				return FIM_ARQ_PREMATURO;
-			else if (sintCmd(token) == SUCESSO)
-				return erro;
-			else
-				return ERRO;
+			}
+			else if (sintCmd(token) != SUCESSO)
+				erro = ERRO;
+
+			otmJuntar(estado, ramo, 1);
+			return erro;
 		}
 		else {
+			otmJuntar(estado, NULL, 0);
+
 			mensagemErro("Esperava-se senao ou fim.");
 
-			const unsigned short int sincro[] = { PONTO_E_VIRGULA, FIM, SENAO,
-					LE, ESCREVE, ENQUANTO, SE, IDENTIFICADOR, INICIO };
-			erro = modoPanico(token, sincro, 9);
+			erro = modoPanico(token, SINC_PRIMEIROS_CMD | SINC_FIM_CMD);
 		}
 
 		break;
@@ -1036,53 +1260,78 @@ tControle sintCmd(tToken *token) {
 
 		/*gerador de codigo*/
 		gecGeraCodigo("\n");
-		gecGeraCodigo(token->cadeia);
 
-		/*codigo do analisador semantico*/
-		semEmpilhaTemp(*token);
+		/*guarda o identificador, sua cadeia continua no fluxo de tokens*/
+		ident = *token;
 
 		if (getToken(token) != SUCESSO)
 			return FIM_ARQ_PREMATURO;
 
 		if (token->signo == DOIS_PONTOS_IGUAL) {
 
-			/*gerador de codigo*/
-			gecGeraCodigo(" = ");
-
 			/*codigo do analisador semantico*/
-			semDesempilhaTemp(token);
-			semVerDeclVar(*token);
-			semEmpilhaTemp(*token);
+			RASTREAR("semVerDeclVar", "semantico", semVerDeclVar(&ident));
+			tipo = semTipoVariavel(ident.cadeia);
 
 			if (getToken(token) != SUCESSO)
 				return FIM_ARQ_PREMATURO;
 			else
-				erro = sintExpressao(token);
+				erro = sintExpressao(token, &expressao);
 
 			/*codigo do analisador semantico*/
-			semVerAtribuicao();
-
-			/*gerador de codigo*/
+			RASTREAR("semTiparExpressao", "semantico", semTiparExpressao(expressao));
+			RASTREAR("semVerAtribuicao", "semantico", semVerAtribuicao(tipo, expressao));
+
+			/*numeracao de valores*/
+			valor = otmExpressao(expressao);
+
+			/*gerador de codigo, a atribuicao que virou copia da propria variavel fica vazia*/
+			if (!expressao || expressao->operador != IDENTIFICADOR
+					|| strcmp(expressao->cadeia, ident.cadeia)) {
+				gecIdentificador(ident.cadeia);
+				gecGeraCodigo(" = ");
+				gecExpressao(expressao, tipo);
+			}
 			gecAddPontoVirgula();
 
+			/*numeracao de valores*/
+			otmAtribuicao(ident.cadeia, tipo, expressao, valor);
+
+			destruirExpressao(&expressao);
+
 			return erro;
 		} else {
 
+			/*procedimento pequeno, o corpo sera escrito no lugar da chamada*/
+			if ((expandir = expExpansivel(ident.cadeia)))
+				gecSuspender(1);
+
 			/*gerador de codigo*/
+			gecGeraCodigo(ident.cadeia);
 			gecGeraCodigo("( ");
 
 			/*codigo do analisador semantico*/
-			tToken proc;
-			semDesempilhaTemp(&proc);
-			semVerDeclProc(proc);
+			RASTREAR("semVerDeclProc", "semantico", semVerDeclProc(&ident));
 
 			erro = sintListaArg(token);
 
 			/*gerador de codigo*/
 			gecGeraCodigo(");\n");
 
+			if (expandir)
+				gecSuspender(0);
+
+			/*numeracao de valores, o procedimento pode alterar as globais*/
+			otmReiniciar();
+
 			/*codigo do analisador semantico*/
-			return semVerParametros(proc.cadeia);
+			if ((erro = RASTREAR("semVerParametros", "semantico", semVerParametros(ident.cadeia))) == SUCESSO
+					&& expandir)
+				erro = expExpandir(ident.cadeia);
+
+			otmReiniciar();
+
+			return erro;
 
 		}
 
@@ -1110,15 +1359,13 @@ tControle sintCmd(tToken *token) {
 		else {
 			mensagemErro("Esperava-se fim.");
 
-			const unsigned short int sincro[] = { PONTO_E_VIRGULA, FIM, SENAO };
-			erro = modoPanico(token, sincro, 3);
+			erro = modoPanico(token, SINC_FIM_CMD);
 		}
 		break;
 
 	default:
 		mensagemErro("Esperava-se primerios de CMD.");
-		const unsigned short int sincro[] = { PONTO_E_VIRGULA, FIM };
-		erro = modoPanico(token, sincro, 2);
+		erro = modoPanico(token, CONJ(PONTO_E_VIRGULA) | CONJ(FIM));
 	}
 
 	return erro;
@@ -1159,9 +1406,7 @@ tControle sintPrograma(tToken *token) {
 
 		mensagemErro("Esperava-se programa.");
 
-		const unsigned short int sincro[] = { IDENTIFICADOR, PONTO_E_VIRGULA,
-				VAR, PROCEDIMENTO, INICIO };
-		modoPanico(token, sincro, 5);
+		modoPanico(token, SINC_DECLARACOES | CONJ(IDENTIFICADOR) | CONJ(PONTO_E_VIRGULA));
 
 		erro = ERRO;
 	}
@@ -1176,9 +1421,7 @@ tControle sintPrograma(tToken *token) {
 
 		mensagemErro("Esperava-se identificador.");
 
-		const unsigned short int sincro[] = { PONTO_E_VIRGULA, VAR,
-				PROCEDIMENTO, INICIO };
-		modoPanico(token, sincro, 4);
+		modoPanico(token, SINC_DECLARACOES | CONJ(PONTO_E_VIRGULA));
 
 		erro = ERRO;
 	}
@@ -1193,8 +1436,7 @@ tControle sintPrograma(tToken *token) {
 
 		mensagemErro("Esperava-se ponto e virgula.");
 
-		const unsigned short int sincro[] = { VAR, PROCEDIMENTO, INICIO };
-		modoPanico(token, sincro, 3);
+		modoPanico(token, SINC_DECLARACOES);
 
 		erro = ERRO;
 	}
@@ -1203,12 +1445,18 @@ tControle sintPrograma(tToken *token) {
 	if (sintDeclaracaoVariaveis(token) != SUCESSO)
 		erro = ERRO;
 
-	/*funcao de declaracao de procedimento*/
-	if (sintDeclaracaoProcedimentos(token) != SUCESSO)
-		erro = ERRO;
+	/*funcao de declaracao de procedimento, em paralelo quando possivel*/
+	if (compilarEmParalelo(token) != SUCESSO)
+		if (sintDeclaracaoProcedimentos(token) != SUCESSO)
+			erro = ERRO;
 
 	/*codigo do gerador*/
+	gecLinha(token->linha, getColunaAtual());
 	gecGeraCodigo("\nint main(void) {\n");
+	gecInicioPrincipal();
+
+	/*numeracao de valores*/
+	otmReiniciar();
 
 	/*para o token inicio*/
 	if (token->signo == INICIO)
@@ -1220,9 +1468,7 @@ tControle sintPrograma(tToken *token) {
 
 		mensagemErro("Esperava-se inicio.");
 
-		const unsigned short int sincro[] = { LE, ESCREVE, ENQUANTO, SE,
-				IDENTIFICADOR, INICIO };
-		erro = modoPanico(token, sincro, 6);
+		erro = modoPanico(token, SINC_PRIMEIROS_CMD);
 	}
 
 	if (sintComando(token) != SUCESSO)
@@ -1237,8 +1483,7 @@ tControle sintPrograma(tToken *token) {
 	else {
 		mensagemErro("Esperava-se fim.");
 
-		const unsigned short int sincro[] = { PONTO_FINAL };
-		erro = modoPanico(token, sincro, 1);
+		erro = modoPanico(token, CONJ(PONTO_FINAL));
 	}
 
 	/*para o ponto-final*/
@@ -1265,38 +1510,78 @@ tControle sintPrograma(tToken *token) {
  * Esta funcao eh a chamadora, ela eh a responsavel por abrir o arquivo
  *  no qual sera impressa a resposta, nesta tamb�m eh declarado o token
  *  que eh utilizado pelo programa, parecido com um token global,
- *  porem passado por referencia sempre. Fica a seu cargo imprimir as
- *  mensagens de conclusao de compilacao.
+ *  porem passado por referencia sempre. Fica a seu cargo relatar a
+ *  conclusao da compilacao.
+ *
+ * @return tControle : SUCESSO, ERRO, FIM_ARQ_PREMATURO ou ARQUIVO_VAZIO.
  */
-void analiseSintatica(void) {
-
-	contErros = 0;
+tControle analiseSintatica(void) {
 
 	auto tToken token;
 	auto tControle erro;
 
+	contErros = 0;
+	escopo = 0;
+
+	/*o fluxo pode ter parado no limite de memoria*/
+	sintConferirMemoria();
+
 	if (getToken(&token) == SUCESSO)
 		erro = sintPrograma(&token);
 	else
 		erro = ARQUIVO_VAZIO;
 
+	concluirAnalise(erro);
+
+	return contErros ? ERRO : erro;
+}
+
+/**
+ * @brief relata a conclusao da analise
+ *
+ * Escreve os diagnosticos e a mensagem de conclusao de compilacao de acordo com
+ *  o resultado da analise e o numero de erros.
+ *
+ * @param erro tControle : resultado da analise.
+ */
+void concluirAnalise(tControle erro) {
+
+	auto char resumo[128];
+	auto const char *situacao;
+
 	if (contErros)
 		erro = ERRO;
 
 	switch (erro) {
 	case SUCESSO:
-		fprintf(stdout, "\nFim de compilacao. :-)\n");
+		situacao = "sucesso";
+		sprintf(resumo, "\nFim de compilacao. :-)\n");
 		break;
 	case FIM_ARQ_PREMATURO:
-		fprintf(stdout, "\nFim de arquivo inesperado. ;-(\n");
+		situacao = "fim_de_arquivo_inesperado";
+		sprintf(resumo, "\nFim de arquivo inesperado. ;-(\n");
 		break;
 	case ERRO:
-		fprintf(stdout,	"\nPrograma escrito com erros. \nOcorreram %u erros\n\t\t Bazinga!!\n",
-				contErros);
+		if (limiteDeMemoriaAtingido()) {
+			situacao = "limite_de_memoria";
+			sprintf(resumo, "\nAnalise interrompida, pico de memoria de %lu MB.\n\t\t Bazinga!!\n",
+					picoMemoriaMegabytes());
+		} else if (limiteDeErrosAtingido()) {
+			situacao = "limite_de_erros";
+			sprintf(resumo, "\nAnalise interrompida apos %u erros.\n\t\t Bazinga!!\n",
+					contErros);
+		} else {
+			situacao = "erros";
+			sprintf(resumo, "\nPrograma escrito com erros. \nOcorreram %u erros\n\t\t Bazinga!!\n",
+					contErros);
+		}
 		break;
-	case ARQUIVO_VAZIO:
-		fprintf(stdout, "\nArquivo vazio. =D\n");
+	default:
+		situacao = "arquivo_vazio";
+		sprintf(resumo, "\nArquivo vazio. =D\n");
 	}
+
+	escreverDiagnosticos(saidaDiagnosticos, situacao, resumo);
 }
 
 #endif
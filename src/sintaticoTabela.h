@@ -0,0 +1,210 @@
+/**
+ * sintaticoTabela.h
+ *
+ * Analisador sintatico dirigido por tabela.
+ *
+ * Alternativa ao analisador de sintatico.h: em vez de um procedimento por grafo,
+ *  um unico laco com uma pilha de simbolos consulta a tabela LL(1) gerada pelo
+ *  geraTabela a partir de alg.gram. As acoes semanticas da gramatica (@nome) sao
+ *  ganchos em acoesLL1, chamados com o token atual quando desempilhadas; ganchos
+ *  nulos sao ignorados. Faz apenas a analise sintatica, sem gerar codigo, e serve
+ *  para comparar as duas tecnicas e estender a gramatica.
+ * O tratamento de erro tambem eh o modo panico, sincronizando nos seguidores do
+ *  nao terminal do topo.
+ *
+ * @see alg.gram
+ * @see geraTabela.c
+ * @see sintatico
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _SINTATICOTABELA_H_
+#define _SINTATICOTABELA_H_
+
+/*includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "padroes.h"
+#include "vetor.h"
+#include "tabelaLL1.h"
+#include "lexico.h"
+#include "sintatico.h"
+
+/*defines*/
+#define PILHA_LL1_INICIAL 256 /*capacidade inicial da pilha de simbolos*/
+
+/*novos tipos*/
+typedef void (*tAcaoLL1)(tToken*); /**gancho de uma acao semantica*/
+
+/*variaveis globais*/
+tAcaoLL1 acoesLL1[LL1_ACOES]; /**ganchos das acoes semanticas, indexados por LL1_ACAO_*/
+static short int colunasLL1[VAR - COMENTARIO_ERRO + 1]; /**coluna da tabela de cada codigo, -1 se nao houver*/
+static short int *pilhaLL1; /**pilha de simbolos*/
+static unsigned int topoLL1; /**numero de simbolos na pilha*/
+static unsigned int capacidadePilhaLL1; /**numero de simbolos alocados*/
+
+/**
+ * Empilha um simbolo.
+ *
+ * A pilha cresce dobrando de tamanho. Funcao para uso interno.
+ *
+ * @param simbolo short int : terminal, nao terminal ou acao.
+ * @return SUCESSO ou ERRO se faltar memoria.
+ */
+static tControle _empilharLL1(short int simbolo) {
+
+	auto short int *nova;
+
+	if (topoLL1 == capacidadePilhaLL1) {
+
+		if (!(nova = (short int*) crescerVetor(pilhaLL1, &capacidadePilhaLL1, topoLL1 + 1,
+				PILHA_LL1_INICIAL, sizeof(short int))))
+			return ERRO;
+		pilhaLL1 = nova;
+	}
+
+	pilhaLL1[topoLL1++] = simbolo;
+	return SUCESSO;
+}
+
+/**
+ * Encontra a producao de um nao terminal para o token atual.
+ *
+ * @param naoTerminal short int : nao terminal, ja sem LL1_BASE_NAO_TERMINAL.
+ * @param token tToken* : token atual.
+ * @param fim signed char : diferente de zero se os tokens acabaram.
+ * @return producao mais um ou zero se nao houver.
+ */
+static unsigned char _producaoLL1(short int naoTerminal, tToken *token, signed char fim) {
+
+	auto short int coluna = fim ? LL1_TERMINAIS : colunasLL1[token->signo - COMENTARIO_ERRO];
+
+	return coluna < 0 ? 0 : tabelaLL1[naoTerminal][coluna];
+}
+
+/**
+ * Laco do analisador dirigido por tabela.
+ *
+ * Desempilha um simbolo por vez: acoes chamam seu gancho, nao terminais sao
+ *  trocados pelo lado direito da producao indicada na tabela e terminais devem
+ *  ser iguais ao token atual. Se um terminal falta ele eh dado como inserido; se
+ *  nao ha producao, tokens sao descartados ate um que a tenha ou que siga o nao
+ *  terminal, que entao eh abandonado.
+ *
+ * @param token tToken* : recebe o primeiro token.
+ *
+ * @return para caso de erro (SUCESSO ou FIM_ARQ_PREMATURO ou ERRO)
+ */
+tControle sintTabela(tToken *token) {
+
+	auto short int simbolo;
+	auto unsigned char producao;
+	auto signed char fim = 0; /*os tokens acabaram*/
+	auto tControle erro = SUCESSO;
+	register int i;
+
+	topoLL1 = 0;
+	_empilharLL1(LL1_INICIAL);
+
+	while (topoLL1) {
+
+		if (!fim && token->signo == COMENTARIO_ERRO) {
+			mensagemErro("Comentario nao fechado.");
+			return FIM_ARQ_PREMATURO;
+		}
+
+		simbolo = pilhaLL1[--topoLL1];
+
+		/*acao semantica*/
+		if (simbolo >= LL1_BASE_ACAO) {
+			if (acoesLL1[simbolo - LL1_BASE_ACAO])
+				acoesLL1[simbolo - LL1_BASE_ACAO](token);
+		}
+		/*nao terminal*/
+		else if (simbolo >= LL1_BASE_NAO_TERMINAL) {
+
+			simbolo -= LL1_BASE_NAO_TERMINAL;
+
+			if ((producao = _producaoLL1(simbolo, token, fim))) {
+				for (i = producoesLL1[producao - 1]; i < producoesLL1[producao]; ++i)
+					if (_empilharLL1(simbolosLL1[i]) != SUCESSO)
+						return ERRO;
+				continue;
+			}
+
+			if (fim)
+				return FIM_ARQ_PREMATURO;
+
+			mensagemErro("Token inesperado.");
+			erro = ERRO;
+
+			/*modo panico, o nao terminal volta para a pilha se algum token
+			 * descartado tiver producao*/
+			while (!PERTENCE(token->signo, seguidoresLL1[simbolo])) {
+				if (getToken(token) != SUCESSO) {
+					fim = 1;
+					break;
+				}
+				if (token->signo == COMENTARIO_ERRO)
+					break;
+				if (_producaoLL1(simbolo, token, fim)) {
+					pilhaLL1[topoLL1++] = simbolo + LL1_BASE_NAO_TERMINAL;
+					break;
+				}
+			}
+		}
+		/*terminal*/
+		else if (fim)
+			return FIM_ARQ_PREMATURO;
+		else if (token->signo == simbolo)
+			fim = getToken(token) != SUCESSO;
+		else {
+			mensagemErro("Token inesperado.");
+			erro = ERRO;
+		}
+	}
+
+	if (!fim) {
+		mensagemErro("Esperava-se fim-de-arquivo");
+		erro = ERRO;
+	}
+
+	return erro;
+}
+
+/**
+ * @brief faz a analise sintatica dirigida por tabela
+ *
+ * Equivalente ao analiseSintatica, porem com o analisador dirigido por tabela.
+ *  Monta o mapa de codigos para colunas, faz a analise e relata a conclusao.
+ */
+void analiseSintaticaTabela(void) {
+
+	auto tToken token;
+	auto tControle erro;
+	register int i;
+
+	contErros = 0;
+
+	for (i = 0; i <= VAR - COMENTARIO_ERRO; ++i)
+		colunasLL1[i] = -1;
+	for (i = 0; i < LL1_TERMINAIS; ++i)
+		colunasLL1[terminaisLL1[i] - COMENTARIO_ERRO] = i;
+
+	if (getToken(&token) == SUCESSO)
+		erro = sintTabela(&token);
+	else
+		erro = ARQUIVO_VAZIO;
+
+	free(pilhaLL1);
+	pilhaLL1 = NULL;
+	topoLL1 = capacidadePilhaLL1 = 0;
+
+	concluirAnalise(erro);
+}
+
+#endif /* _SINTATICOTABELA_H_ */
@@ -0,0 +1,146 @@
+/**
+ * tabelaLL1.h
+ *
+ * Tabela LL(1) da linguagem ALG gerada pelo geraTabela a partir de alg.gram.
+ *  Nao edite este arquivo, edite a gramatica.
+ *
+ * @see sintaticoTabela
+ */
+
+#ifndef _TABELALL1_H_
+#define _TABELALL1_H_
+
+#include "padroes.h"
+
+#define LL1_TERMINAIS 34 /*o terminal LL1_TERMINAIS eh o final do arquivo*/
+#define LL1_NAO_TERMINAIS 27
+#define LL1_ACOES 3
+#define LL1_PRODUCOES 58
+#define LL1_BASE_NAO_TERMINAL 200 /*simbolos a partir daqui sao nao terminais*/
+#define LL1_BASE_ACAO 300 /*simbolos a partir daqui sao acoes*/
+#define LL1_INICIAL (LL1_BASE_NAO_TERMINAL + 0)
+
+#define LL1_ACAO_corpoPrincipal 0
+#define LL1_ACAO_inicioProcedimento 1
+#define LL1_ACAO_fimProcedimento 2
+
+/*codigo de cada coluna da tabela*/
+static const tCodigoToken terminaisLL1[LL1_TERMINAIS] = {
+	PROGRAMA, IDENTIFICADOR, PONTO_E_VIRGULA, INICIO, FIM, PONTO_FINAL,
+	VAR, DOIS_PONTOS, REAL, INTEIRO, VIRGULA, PROCEDIMENTO,
+	ABRE_PARENTESES, FECHA_PARENTESES, LE, ESCREVE, ENQUANTO, FACA,
+	SE, ENTAO, SENAO, DOIS_PONTOS_IGUAL, IGUAL, DIFERENTE,
+	MAIOR_IGUAL, MENOR_IGUAL, MAIOR, MENOR, MAIS, MENOS,
+	ASTERISCO, BARRA, NUMERO_INTEIRO, NUMERO_REAL };
+
+static const char *const naoTerminaisLL1[LL1_NAO_TERMINAIS] = {
+	"programa", "dc_v", "dc_p", "comandos", "variaveis", "tipo",
+	"mais_var", "parametros", "corpo_p", "lista_par", "mais_par", "cmd",
+	"condicao", "pfalsa", "resto_ident", "expressao", "lista_arg", "argumentos",
+	"mais_ident", "relacao", "termo", "outros_termos", "op_un", "fator",
+	"mais_fatores", "op_ad", "op_mul" };
+
+/*lados direitos das producoes, em ordem inversa*/
+static const short int simbolosLL1[] = {
+	PONTO_FINAL, FIM, 203, INICIO, 300, 202, 201, PONTO_E_VIRGULA,
+	IDENTIFICADOR, PROGRAMA, 201, PONTO_E_VIRGULA, 205, DOIS_PONTOS, 204, VAR,
+	REAL, INTEIRO, 206, IDENTIFICADOR, 204, VIRGULA, 202, 302,
+	208, PONTO_E_VIRGULA, 207, IDENTIFICADOR, 301, PROCEDIMENTO, FECHA_PARENTESES, 209,
+	ABRE_PARENTESES, 210, 205, DOIS_PONTOS, 204, 209, PONTO_E_VIRGULA, PONTO_E_VIRGULA,
+	FIM, 203, INICIO, 201, 203, PONTO_E_VIRGULA, 211, FECHA_PARENTESES,
+	204, ABRE_PARENTESES, LE, FECHA_PARENTESES, 204, ABRE_PARENTESES, ESCREVE, 211,
+	FACA, 212, ENQUANTO, 213, 211, ENTAO, 212, SE,
+	214, IDENTIFICADOR, FIM, 203, INICIO, 211, SENAO, FIM,
+	215, DOIS_PONTOS_IGUAL, 216, FECHA_PARENTESES, 217, ABRE_PARENTESES, 218, IDENTIFICADOR,
+	217, PONTO_E_VIRGULA, 215, 219, 215, IGUAL, DIFERENTE, MAIOR_IGUAL,
+	MENOR_IGUAL, MAIOR, MENOR, 221, 220, 224, 223, 222,
+	MAIS, MENOS, 221, 220, 225, MAIS, MENOS, 224,
+	223, 226, ASTERISCO, BARRA, IDENTIFICADOR, NUMERO_INTEIRO, NUMERO_REAL, FECHA_PARENTESES,
+	215, ABRE_PARENTESES,
+	0 };
+
+/*inicio de cada producao em simbolosLL1, a ultima marca o final*/
+static const unsigned short int producoesLL1[LL1_PRODUCOES + 1] = {
+	0, 10, 16, 16, 17, 18, 20, 22, 22, 30, 30, 33, 33, 37, 39, 39,
+	44, 47, 47, 51, 55, 59, 64, 66, 69, 71, 72, 74, 75, 78, 78, 80,
+	80, 82, 82, 85, 86, 87, 88, 89, 90, 91, 93, 96, 97, 98, 98, 101,
+	101, 102, 103, 106, 106, 107, 108, 109, 110, 111, 114, };
+
+/*producao mais um para cada nao terminal e terminal, zero eh erro*/
+static const unsigned char tabelaLL1[LL1_NAO_TERMINAIS][LL1_TERMINAIS + 1] = {
+	{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,3,0,0,2,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,10,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,17,0,17,18,0,0,0,0,0,0,0,0,0,17,17,17,0,17,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,4,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,8,0,0,7,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,12,0,0,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,16,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,14,0,0,0,0,0,0,0,0,0,0,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,23,0,24,0,0,0,0,0,0,0,0,0,0,19,20,21,0,22,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,35,0,0,0,0,0,0,0,0,0,0,35,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,35,35,0,0,35,35,0},
+	{0,0,0,0,26,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,28,0,28,0,0,0,0,0,0,0,28,0,0,0,0,0,0,0,28,27,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,42,0,0,0,0,0,0,0,0,0,0,42,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,42,42,0,0,42,42,0},
+	{0,0,30,0,30,0,0,0,0,0,0,0,29,0,0,0,0,0,0,0,30,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,31,0,0,0,0,0,0,0,0,0,0,0,32,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,33,0,0,0,0,0,0,0,0,0,0,34,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,36,37,38,39,40,41,0,0,0,0,0,0,0},
+	{0,43,0,0,0,0,0,0,0,0,0,0,43,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,43,43,0,0,43,43,0},
+	{0,0,48,0,48,0,0,0,0,0,0,0,0,48,0,0,0,48,0,48,48,0,48,48,48,48,48,48,47,47,0,0,0,0,0},
+	{0,46,0,0,0,0,0,0,0,0,0,0,46,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,44,45,0,0,46,46,0},
+	{0,55,0,0,0,0,0,0,0,0,0,0,58,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,56,57,0},
+	{0,0,52,0,52,0,0,0,0,0,0,0,0,52,0,0,0,52,0,52,52,0,52,52,52,52,52,52,52,52,51,51,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,49,50,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,53,54,0,0,0},
+};
+
+/*seguidores de cada nao terminal, para o modo panico*/
+static const tConjuntoTokens seguidoresLL1[LL1_NAO_TERMINAIS] = {
+	0,
+	CONJ(INICIO) | CONJ(PROCEDIMENTO),
+	CONJ(INICIO),
+	CONJ(FIM),
+	CONJ(DOIS_PONTOS) | CONJ(FECHA_PARENTESES),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FECHA_PARENTESES),
+	CONJ(DOIS_PONTOS) | CONJ(FECHA_PARENTESES),
+	CONJ(PONTO_E_VIRGULA),
+	CONJ(INICIO) | CONJ(PROCEDIMENTO),
+	CONJ(FECHA_PARENTESES),
+	CONJ(FECHA_PARENTESES),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(SENAO),
+	CONJ(FACA) | CONJ(ENTAO),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(SENAO),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(SENAO),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(FECHA_PARENTESES) | CONJ(FACA)
+		| CONJ(ENTAO) | CONJ(SENAO) | CONJ(IGUAL) | CONJ(DIFERENTE)
+		| CONJ(MAIOR_IGUAL) | CONJ(MENOR_IGUAL) | CONJ(MAIOR) | CONJ(MENOR),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(SENAO),
+	CONJ(FECHA_PARENTESES),
+	CONJ(FECHA_PARENTESES),
+	CONJ(IDENTIFICADOR) | CONJ(ABRE_PARENTESES) | CONJ(MAIS) | CONJ(MENOS)
+		| CONJ(NUMERO_INTEIRO) | CONJ(NUMERO_REAL),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(FECHA_PARENTESES) | CONJ(FACA)
+		| CONJ(ENTAO) | CONJ(SENAO) | CONJ(IGUAL) | CONJ(DIFERENTE)
+		| CONJ(MAIOR_IGUAL) | CONJ(MENOR_IGUAL) | CONJ(MAIOR) | CONJ(MENOR)
+		| CONJ(MAIS) | CONJ(MENOS),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(FECHA_PARENTESES) | CONJ(FACA)
+		| CONJ(ENTAO) | CONJ(SENAO) | CONJ(IGUAL) | CONJ(DIFERENTE)
+		| CONJ(MAIOR_IGUAL) | CONJ(MENOR_IGUAL) | CONJ(MAIOR) | CONJ(MENOR),
+	CONJ(IDENTIFICADOR) | CONJ(ABRE_PARENTESES) | CONJ(NUMERO_INTEIRO) | CONJ(NUMERO_REAL),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(FECHA_PARENTESES) | CONJ(FACA)
+		| CONJ(ENTAO) | CONJ(SENAO) | CONJ(IGUAL) | CONJ(DIFERENTE)
+		| CONJ(MAIOR_IGUAL) | CONJ(MENOR_IGUAL) | CONJ(MAIOR) | CONJ(MENOR)
+		| CONJ(MAIS) | CONJ(MENOS) | CONJ(ASTERISCO) | CONJ(BARRA),
+	CONJ(PONTO_E_VIRGULA) | CONJ(FIM) | CONJ(FECHA_PARENTESES) | CONJ(FACA)
+		| CONJ(ENTAO) | CONJ(SENAO) | CONJ(IGUAL) | CONJ(DIFERENTE)
+		| CONJ(MAIOR_IGUAL) | CONJ(MENOR_IGUAL) | CONJ(MAIOR) | CONJ(MENOR)
+		| CONJ(MAIS) | CONJ(MENOS),
+	CONJ(IDENTIFICADOR) | CONJ(ABRE_PARENTESES) | CONJ(MAIS) | CONJ(MENOS)
+		| CONJ(NUMERO_INTEIRO) | CONJ(NUMERO_REAL),
+	CONJ(IDENTIFICADOR) | CONJ(ABRE_PARENTESES) | CONJ(NUMERO_INTEIRO) | CONJ(NUMERO_REAL),
+};
+
+#endif /* _TABELALL1_H_ */
@@ -0,0 +1,57 @@
+/**
+ * vetor.h
+ *
+ * Vetores que crescem por dobra.
+ *
+ * Os vetores do compilador guardam o numero de elementos alocados ao lado do
+ *  ponteiro e dobram quando enchem. O crescimento fica aqui, em um lugar so: a
+ *  capacidade so eh trocada depois que o realloc deu certo, assim uma falta de
+ *  memoria deixa o vetor antigo valido e coerente com a sua capacidade.
+ *
+ * @see fila
+ *
+ * @author Carlos Roberto Silveira Junior
+ * @author Lais Augusta da Silva Meuchi
+ *
+ * @version 2009.11.28
+ */
+
+#ifndef _VETOR_H_
+#define _VETOR_H_
+
+/*includes*/
+#include <stdlib.h>
+
+/*funcoes e procedimentos*/
+/**
+ * Garante espaco em um vetor que cresce por dobra.
+ *
+ * A capacidade dobra, a partir da inicial, ate caberem os elementos pedidos.
+ *
+ * @param vetor void* : vetor atual, nulo se ainda nao foi alocado.
+ * @param capacidade unsigned int* : elementos alocados, trocada apenas se o
+ *         vetor crescer.
+ * @param necessario unsigned int : elementos que devem caber.
+ * @param inicial unsigned int : capacidade da primeira alocacao, maior que zero.
+ * @param tamanho size_t : bytes de um elemento.
+ * @return o vetor, que pode ter mudado de lugar, ou NULL se faltar memoria; nesse
+ *          caso o vetor antigo continua alocado.
+ */
+void *crescerVetor(void *vetor, unsigned int *capacidade, unsigned int necessario,
+		unsigned int inicial, size_t tamanho) {
+
+	auto unsigned int nova = *capacidade;
+
+	if (necessario <= nova)
+		return vetor;
+
+	while (nova < necessario)
+		nova = nova ? 2 * nova : inicial;
+
+	if ((vetor = realloc(vetor, nova * tamanho)))
+		*capacidade = nova;
+
+	return vetor;
+}
+
+#endif /* _VETOR_H_ */